@@ -302,13 +302,18 @@ void loop() {
     printPercent(readLength, contentLength);
     while (readLength < contentLength && client.connected() && millis() - clientReadStartTime < clientReadTimeout) {
       while (client.available()) {
-        uint8_t c = client.read();
-        //SerialMon.print(reinterpret_cast<char>c);  // Uncomment this to show data
-        crc.update(c);
-        readLength++;
-        if (readLength % (contentLength / 13) == 0) {
-          printPercent(readLength, contentLength);
+        // Reading in blocks lets the modem hand over the data without staging
+        // it in the client's small receive buffer
+        uint8_t buf[256];
+        int n = client.read(buf, sizeof(buf));
+        if (n <= 0) break;
+        //SerialMon.write(buf, n);  // Uncomment this to show data
+        crc.update(buf, n);
+        uint32_t step = contentLength / 13;
+        if ((readLength + n) / step != readLength / step) {
+          printPercent(readLength + n, contentLength);
         }
+        readLength += n;
         clientReadStartTime = millis();
       }
     }
@@ -10,6 +10,8 @@
 #define SRC_TINYGSMBATTERY_H_
 
 #include "TinyGsmCommon.h"
+#include "TinyGsmFields.h"
+#include "TinyGsmThread.h"
 
 #define TINY_GSM_MODEM_HAS_BATTERY
 
@@ -20,16 +22,20 @@ class TinyGsmBattery {
    * Battery functions
    */
   uint16_t getBattVoltage() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getBattVoltageImpl();
   }
   int8_t getBattPercent() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getBattPercentImpl();
   }
   uint8_t getBattChargeState() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getBattChargeStateImpl();
   }
   bool getBattStats(uint8_t& chargeState, int8_t& percent,
                     uint16_t& milliVolts) {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getBattStatsImpl(chargeState, percent, milliVolts);
   }
 
@@ -52,43 +58,46 @@ class TinyGsmBattery {
   uint16_t getBattVoltageImpl() {
     thisModem().sendAT(GF("+CBC"));
     if (thisModem().waitResponse(GF("+CBC:")) != 1) { return 0; }
-    thisModem().streamSkipUntil(',');  // Skip battery charge status
-    thisModem().streamSkipUntil(',');  // Skip battery charge level
-    // return voltage in mV
-    uint16_t res = thisModem().streamGetIntBefore('\n');
+    // <bcs>,<bcl>,<voltage>
+    TinyGsmFields fields;
+    thisModem().streamGetFields(fields);
     // Wait for final OK
     thisModem().waitResponse();
-    return res;
+    // return voltage in mV
+    return fields.toInt(2);
   }
 
   int8_t getBattPercentImpl() {
     thisModem().sendAT(GF("+CBC"));
     if (thisModem().waitResponse(GF("+CBC:")) != 1) { return false; }
-    thisModem().streamSkipUntil(',');  // Skip battery charge status
-    // Read battery charge level
-    int8_t res = thisModem().streamGetIntBefore(',');
+    TinyGsmFields fields;
+    thisModem().streamGetFields(fields);
     // Wait for final OK
     thisModem().waitResponse();
-    return res;
+    // Battery charge level
+    return fields.toInt(1);
   }
 
   uint8_t getBattChargeStateImpl() {
     thisModem().sendAT(GF("+CBC"));
     if (thisModem().waitResponse(GF("+CBC:")) != 1) { return false; }
-    // Read battery charge status
-    int8_t res = thisModem().streamGetIntBefore(',');
+    TinyGsmFields fields;
+    thisModem().streamGetFields(fields);
     // Wait for final OK
     thisModem().waitResponse();
-    return res;
+    // Battery charge status
+    return fields.toInt(0);
   }
 
   bool getBattStatsImpl(uint8_t& chargeState, int8_t& percent,
                         uint16_t& milliVolts) {
     thisModem().sendAT(GF("+CBC"));
     if (thisModem().waitResponse(GF("+CBC:")) != 1) { return false; }
-    chargeState = thisModem().streamGetIntBefore(',');
-    percent     = thisModem().streamGetIntBefore(',');
-    milliVolts  = thisModem().streamGetIntBefore('\n');
+    TinyGsmFields fields;
+    thisModem().streamGetFields(fields);
+    chargeState = fields.toInt(0);
+    percent     = fields.toInt(1);
+    milliVolts  = fields.toInt(2);
     // Wait for final OK
     thisModem().waitResponse();
     return true;
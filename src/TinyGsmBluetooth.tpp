@@ -10,6 +10,7 @@
 #define SRC_TINYGSMBLUETOOTH_H_
 
 #include "TinyGsmCommon.h"
+#include "TinyGsmThread.h"
 
 #define TINY_GSM_MODEM_HAS_BLUETOOTH
 
@@ -20,15 +21,19 @@ class TinyGsmBluetooth {
    * Bluetooth functions
    */
   bool enableBluetooth() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().enableBluetoothImpl();
   }
   bool disableBluetooth() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().disableBluetoothImpl();
   }
   bool setBluetoothVisibility(bool visible) {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().setBluetoothVisibilityImpl(visible);
   }
   bool setBluetoothHostName(const char* name) {
+	TINY_GSM_MODEM_LOCK();
 	return thisModem().setBluetoothHostNameImpl(name);
   }
   
@@ -10,6 +10,7 @@
 #define SRC_TINYGSMCALLING_H_
 
 #include "TinyGsmCommon.h"
+#include "TinyGsmThread.h"
 
 #define TINY_GSM_MODEM_HAS_CALLING
 
@@ -20,15 +21,19 @@ class TinyGsmCalling {
    * Phone Call functions
    */
   bool callAnswer() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().callAnswerImpl();
   }
   bool callNumber(const String& number) {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().callNumberImpl(number);
   }
   bool callHangup() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().callHangupImpl();
   }
   bool dtmfSend(char cmd, int duration_ms = 100) {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().dtmfSendImpl(cmd, duration_ms);
   }
 
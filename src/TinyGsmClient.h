@@ -11,15 +11,17 @@
 
 #if defined(TINY_GSM_MODEM_SIM800)
 #include "TinyGsmClientSIM800.h"
-typedef TinyGsmSim800                        TinyGsm;
-typedef TinyGsmSim800::GsmClientSim800       TinyGsmClient;
-typedef TinyGsmSim800::GsmClientSecureSim800 TinyGsmClientSecure;
+typedef TinyGsmSim800                             TinyGsm;
+typedef TinyGsmSim800::GsmClientSim800            TinyGsmClient;
+typedef TinyGsmSim800::GsmClientSecureSim800      TinyGsmClientSecure;
+typedef TinyGsmSim800::GsmClientTransparentSim800 TinyGsmClientTransparent;
 
 #elif defined(TINY_GSM_MODEM_SIM808) || defined(TINY_GSM_MODEM_SIM868)
 #include "TinyGsmClientSIM808.h"
-typedef TinyGsmSim808                        TinyGsm;
-typedef TinyGsmSim808::GsmClientSim800       TinyGsmClient;
-typedef TinyGsmSim808::GsmClientSecureSim800 TinyGsmClientSecure;
+typedef TinyGsmSim808                             TinyGsm;
+typedef TinyGsmSim808::GsmClientSim800            TinyGsmClient;
+typedef TinyGsmSim808::GsmClientSecureSim800      TinyGsmClientSecure;
+typedef TinyGsmSim808::GsmClientTransparentSim800 TinyGsmClientTransparent;
 
 #elif defined(TINY_GSM_MODEM_SIM900)
 #include "TinyGsmClientSIM800.h"
@@ -118,4 +120,21 @@ typedef TinyGsmSequansMonarch::GsmClientSecureSequansMonarch
 #error "Please define GSM modem model"
 #endif
 
+// A client with its own N-byte receive buffer, for sockets that move a lot of
+// data; see GsmClient::setRxBuffer()
+template <size_t N>
+class TinyGsmClientBuffered : public TinyGsmClient {
+ public:
+  TinyGsmClientBuffered() {
+    this->setRxBuffer(buffer, N);
+  }
+  explicit TinyGsmClientBuffered(TinyGsm& modem, uint8_t mux = 0)
+      : TinyGsmClient(modem, mux) {
+    this->setRxBuffer(buffer, N);
+  }
+
+ private:
+  uint8_t buffer[N];
+};
+
 #endif  // SRC_TINYGSMCLIENT_H_
@@ -80,6 +80,7 @@ class TinyGsmA6 : public TinyGsmModem<TinyGsmA6>,
 
    public:
     int connect(const char* host, uint16_t port, int timeout_s) {
+      TINY_GSM_LOCK(at->commandLock());
       stop();
       TINY_GSM_YIELD();
       rx.clear();
@@ -94,6 +95,8 @@ class TinyGsmA6 : public TinyGsmModem<TinyGsmA6>,
     TINY_GSM_CLIENT_CONNECT_OVERRIDES
 
     void stop(uint32_t maxWaitMs) {
+      TINY_GSM_LOCK(at->commandLock());
+      endTx();
       TINY_GSM_YIELD();
       at->sendAT(GF("+CIPCLOSE="), mux);
       sock_connected = false;
@@ -394,12 +397,12 @@ class TinyGsmA6 : public TinyGsmModem<TinyGsmA6>,
   int8_t getBattPercentImpl() {
     sendAT(GF("+CBC?"));
     if (waitResponse(GF(GSM_NL "+CBC:")) != 1) { return false; }
-    streamSkipUntil(',');  // Skip battery charge status
-    // Read battery charge level
-    int8_t res = streamGetIntBefore('\n');
+    TinyGsmFields fields;
+    streamGetFields(fields);
     // Wait for final OK
     waitResponse();
-    return res;
+    // Battery charge level
+    return fields.toInt(1);
   }
 
   // Needs a '?' after CBC, unlike most
@@ -407,8 +410,10 @@ class TinyGsmA6 : public TinyGsmModem<TinyGsmA6>,
                         uint16_t& milliVolts) {
     sendAT(GF("+CBC?"));
     if (waitResponse(GF(GSM_NL "+CBC:")) != 1) { return false; }
-    chargeState = streamGetIntBefore(',');
-    percent     = streamGetIntBefore('\n');
+    TinyGsmFields fields;
+    streamGetFields(fields);
+    chargeState = fields.toInt(0);
+    percent     = fields.toInt(1);
     milliVolts  = 0;
     // Wait for final OK
     waitResponse();
@@ -458,7 +463,6 @@ class TinyGsmA6 : public TinyGsmModem<TinyGsmA6>,
    * Utilities
    */
  public:
-  // TODO(vshymanskyy): Optimize this!
   int8_t waitResponse(uint32_t timeout_ms, String& data,
                       GsmConstStr r1 = GFP(GSM_OK),
                       GsmConstStr r2 = GFP(GSM_ERROR),
@@ -469,79 +473,7 @@ class TinyGsmA6 : public TinyGsmModem<TinyGsmA6>,
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    /*String r1s(r1); r1s.trim();
-    String r2s(r2); r2s.trim();
-    String r3s(r3); r3s.trim();
-    String r4s(r4); r4s.trim();
-    String r5s(r5); r5s.trim();
-    DBG("### ..:", r1s, ",", r2s, ",", r3s, ",", r4s, ",", r5s);*/
-    data.reserve(64);
-    uint8_t  index       = 0;
-    uint32_t startMillis = millis();
-    do {
-      TINY_GSM_YIELD();
-      while (stream.available() > 0) {
-        TINY_GSM_YIELD();
-        int8_t a = stream.read();
-        if (a <= 0) continue;  // Skip 0x00 bytes, just in case
-        data += static_cast<char>(a);
-        if (r1 && data.endsWith(r1)) {
-          index = 1;
-          goto finish;
-        } else if (r2 && data.endsWith(r2)) {
-          index = 2;
-          goto finish;
-        } else if (r3 && data.endsWith(r3)) {
-#if defined TINY_GSM_DEBUG
-          if (r3 == GFP(GSM_CME_ERROR)) {
-            streamSkipUntil('\n');  // Read out the error
-          }
-#endif
-          index = 3;
-          goto finish;
-        } else if (r4 && data.endsWith(r4)) {
-          index = 4;
-          goto finish;
-        } else if (r5 && data.endsWith(r5)) {
-          index = 5;
-          goto finish;
-        } else if (data.endsWith(GF("+CIPRCV:"))) {
-          int8_t  mux      = streamGetIntBefore(',');
-          int16_t len      = streamGetIntBefore(',');
-          int16_t len_orig = len;
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-            if (len > sockets[mux]->rx.free()) {
-              DBG("### Buffer overflow: ", len, "->", sockets[mux]->rx.free());
-            } else {
-              DBG("### Got: ", len, "->", sockets[mux]->rx.free());
-            }
-            while (len--) { moveCharFromStreamToFifo(mux); }
-            // TODO(?) Deal with missing characters
-            if (len_orig > sockets[mux]->available()) {
-              DBG("### Fewer characters received than expected: ",
-                  sockets[mux]->available(), " vs ", len_orig);
-            }
-          }
-          data = "";
-        } else if (data.endsWith(GF("+TCPCLOSED:"))) {
-          int8_t mux = streamGetIntBefore('\n');
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-            sockets[mux]->sock_connected = false;
-          }
-          data = "";
-          DBG("### Closed: ", mux);
-        }
-      }
-    } while (millis() - startMillis < timeout_ms);
-  finish:
-    if (!index) {
-      data.trim();
-      if (data.length()) { DBG("### Unhandled:", data); }
-      data = "";
-    }
-    // data.replace(GSM_NL, "/");
-    // DBG('<', index, '>', data);
-    return index;
+    return parseResponse(timeout_ms, &data, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(uint32_t timeout_ms, GsmConstStr r1 = GFP(GSM_OK),
@@ -553,8 +485,7 @@ class TinyGsmA6 : public TinyGsmModem<TinyGsmA6>,
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    String data;
-    return waitResponse(timeout_ms, data, r1, r2, r3, r4, r5);
+    return parseResponse(timeout_ms, NULL, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(GsmConstStr r1 = GFP(GSM_OK),
@@ -569,6 +500,49 @@ class TinyGsmA6 : public TinyGsmModem<TinyGsmA6>,
     return waitResponse(1000, r1, r2, r3, r4, r5);
   }
 
+ protected:
+  // URCs, matched anywhere in the modem's output
+  static UrcTable urcTable() {
+    static constexpr Urc urcs[] TINY_GSM_PROGMEM = {
+        {"+CIPRCV:", &TinyGsmA6::onCipRcv},
+        {"+TCPCLOSED:", &TinyGsmA6::onTcpClosed},
+        {GSM_NL "+CREG:", &TinyGsmA6::onCreg},
+        {GSM_NL "+CGEV:", &TinyGsmA6::onBearerEvent},
+        {"", NULL}};
+    typedef TinyGsmTrie<TinyGsmTrieSize(urcs)> Trie;
+    static constexpr Trie trie TINY_GSM_PROGMEM = Trie::of(urcs);
+    return {urcs, trie.nodes};
+  }
+
+  bool onCipRcv(UrcContext&) {
+    int8_t  mux      = streamGetIntBefore(',');
+    int16_t len      = streamGetIntBefore(',');
+    int16_t len_orig = len;
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      if (len > sockets[mux]->rx.free()) {
+        DBG("### Buffer overflow: ", len, "->", sockets[mux]->rx.free());
+      } else {
+        DBG("### Got: ", len, "->", sockets[mux]->rx.free());
+      }
+      if (len > 0) { moveCharsFromStreamToFifo(mux, len); }
+      // TODO(?) Deal with missing characters
+      if (len_orig > sockets[mux]->available()) {
+        DBG("### Fewer characters received than expected: ",
+            sockets[mux]->available(), " vs ", len_orig);
+      }
+    }
+    return true;
+  }
+
+  bool onTcpClosed(UrcContext&) {
+    int8_t mux = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = false;
+    }
+    DBG("### Closed: ", mux);
+    return true;
+  }
+
  public:
   Stream& stream;
 
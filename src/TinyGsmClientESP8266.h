@@ -77,6 +77,7 @@ class TinyGsmESP8266 : public TinyGsmModem<TinyGsmESP8266>,
 
    public:
     virtual int connect(const char* host, uint16_t port, int timeout_s) {
+      TINY_GSM_LOCK(at->commandLock());
       stop();
       TINY_GSM_YIELD();
       rx.clear();
@@ -86,6 +87,8 @@ class TinyGsmESP8266 : public TinyGsmModem<TinyGsmESP8266>,
     TINY_GSM_CLIENT_CONNECT_OVERRIDES
 
     void stop(uint32_t maxWaitMs) {
+      TINY_GSM_LOCK(at->commandLock());
+      endTx();
       TINY_GSM_YIELD();
       at->sendAT(GF("+CIPCLOSE="), mux);
       sock_connected = false;
@@ -116,6 +119,7 @@ class TinyGsmESP8266 : public TinyGsmModem<TinyGsmESP8266>,
 
    public:
     int connect(const char* host, uint16_t port, int timeout_s) override {
+      TINY_GSM_LOCK(at->commandLock());
       stop();
       TINY_GSM_YIELD();
       rx.clear();
@@ -232,6 +236,12 @@ class TinyGsmESP8266 : public TinyGsmModem<TinyGsmESP8266>,
     return res2;
   }
 
+  bool getSignalSampleImpl(TinyGsmSignalSample& sample) {
+    sample      = TinyGsmSignalSample();
+    sample.rssi = getSignalQualityImpl();
+    return sample.rssi != 0;
+  }
+
   bool isNetworkConnectedImpl() {
     RegStatus s = getRegistrationStatus();
     if (s == REG_OK_IP || s == REG_OK_TCP) {
@@ -258,6 +268,11 @@ class TinyGsmESP8266 : public TinyGsmModem<TinyGsmESP8266>,
     return res2;
   }
 
+  // No bearer event reports to keep the bearer state by
+  bool bearerReportsImpl() {
+    return false;
+  }
+
   /*
    * WiFi functions
    */
@@ -327,14 +342,13 @@ class TinyGsmESP8266 : public TinyGsmModem<TinyGsmESP8266>,
       uint8_t has_status = waitResponse(GF("+CIPSTATUS:"), GFP(GSM_OK),
                                         GFP(GSM_ERROR));
       if (has_status == 1) {
-        int8_t returned_mux = streamGetIntBefore(',');
-        streamSkipUntil(',');   // Skip mux
-        streamSkipUntil(',');   // Skip type
-        streamSkipUntil(',');   // Skip remote IP
-        streamSkipUntil(',');   // Skip remote port
-        streamSkipUntil(',');   // Skip local port
-        streamSkipUntil('\n');  // Skip client/server type
-        verified_connections[returned_mux] = 1;
+        // <mux>,<type>,<remote IP>,<remote port>,<local port>,<client/server>
+        TinyGsmFields fields;
+        streamGetFields(fields);
+        int8_t returned_mux = fields.toInt(0);
+        if (returned_mux >= 0 && returned_mux < TINY_GSM_MUX_COUNT) {
+          verified_connections[returned_mux] = 1;
+        }
       }
       if (has_status == 2) break;  // once we get to the ok, stop
     }
@@ -350,90 +364,17 @@ class TinyGsmESP8266 : public TinyGsmModem<TinyGsmESP8266>,
    * Utilities
    */
  public:
-  // TODO(vshymanskyy): Optimize this!
   int8_t waitResponse(uint32_t timeout_ms, String& data,
                       GsmConstStr r1 = GFP(GSM_OK),
                       GsmConstStr r2 = GFP(GSM_ERROR), GsmConstStr r3 = NULL,
                       GsmConstStr r4 = NULL, GsmConstStr r5 = NULL) {
-    /*String r1s(r1); r1s.trim();
-    String r2s(r2); r2s.trim();
-    String r3s(r3); r3s.trim();
-    String r4s(r4); r4s.trim();
-    String r5s(r5); r5s.trim();
-    DBG("### ..:", r1s, ",", r2s, ",", r3s, ",", r4s, ",", r5s);*/
-    data.reserve(64);
-    uint8_t  index       = 0;
-    uint32_t startMillis = millis();
-    do {
-      TINY_GSM_YIELD();
-      while (stream.available() > 0) {
-        TINY_GSM_YIELD();
-        int8_t a = stream.read();
-        if (a <= 0) continue;  // Skip 0x00 bytes, just in case
-        data += static_cast<char>(a);
-        if (r1 && data.endsWith(r1)) {
-          index = 1;
-          goto finish;
-        } else if (r2 && data.endsWith(r2)) {
-          index = 2;
-          goto finish;
-        } else if (r3 && data.endsWith(r3)) {
-          index = 3;
-          goto finish;
-        } else if (r4 && data.endsWith(r4)) {
-          index = 4;
-          goto finish;
-        } else if (r5 && data.endsWith(r5)) {
-          index = 5;
-          goto finish;
-        } else if (data.endsWith(GF("+IPD,"))) {
-          int8_t  mux      = streamGetIntBefore(',');
-          int16_t len      = streamGetIntBefore(':');
-          int16_t len_orig = len;
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-            if (len > sockets[mux]->rx.free()) {
-              DBG("### Buffer overflow: ", len, "received vs",
-                  sockets[mux]->rx.free(), "available");
-            } else {
-              // DBG("### Got Data: ", len, "on", mux);
-            }
-            while (len--) { moveCharFromStreamToFifo(mux); }
-            // TODO(SRGDamia1): deal with buffer overflow/missed characters
-            if (len_orig > sockets[mux]->available()) {
-              DBG("### Fewer characters received than expected: ",
-                  sockets[mux]->available(), " vs ", len_orig);
-            }
-          }
-          data = "";
-        } else if (data.endsWith(GF("CLOSED"))) {
-          int8_t muxStart =
-              TinyGsmMax(0, data.lastIndexOf(GSM_NL, data.length() - 8));
-          int8_t coma = data.indexOf(',', muxStart);
-          int8_t mux  = data.substring(muxStart, coma).toInt();
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-            sockets[mux]->sock_connected = false;
-          }
-          data = "";
-          DBG("### Closed: ", mux);
-        }
-      }
-    } while (millis() - startMillis < timeout_ms);
-  finish:
-    if (!index) {
-      data.trim();
-      if (data.length()) { DBG("### Unhandled:", data); }
-      data = "";
-    }
-    // data.replace(GSM_NL, "/");
-    // DBG('<', index, '>', data);
-    return index;
+    return parseResponse(timeout_ms, &data, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(uint32_t timeout_ms, GsmConstStr r1 = GFP(GSM_OK),
                       GsmConstStr r2 = GFP(GSM_ERROR), GsmConstStr r3 = NULL,
                       GsmConstStr r4 = NULL, GsmConstStr r5 = NULL) {
-    String data;
-    return waitResponse(timeout_ms, data, r1, r2, r3, r4, r5);
+    return parseResponse(timeout_ms, NULL, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(GsmConstStr r1 = GFP(GSM_OK),
@@ -442,6 +383,48 @@ class TinyGsmESP8266 : public TinyGsmModem<TinyGsmESP8266>,
     return waitResponse(1000, r1, r2, r3, r4, r5);
   }
 
+ protected:
+  // URCs, matched anywhere in the modem's output
+  static UrcTable urcTable() {
+    static constexpr Urc urcs[] TINY_GSM_PROGMEM = {
+        {"+IPD,", &TinyGsmESP8266::onIpd},
+        {"CLOSED", &TinyGsmESP8266::onClosed},
+        {"", NULL}};
+    typedef TinyGsmTrie<TinyGsmTrieSize(urcs)> Trie;
+    static constexpr Trie trie TINY_GSM_PROGMEM = Trie::of(urcs);
+    return {urcs, trie.nodes};
+  }
+
+  bool onIpd(UrcContext&) {
+    int8_t  mux      = streamGetIntBefore(',');
+    int16_t len      = streamGetIntBefore(':');
+    int16_t len_orig = len;
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      if (len > sockets[mux]->rx.free()) {
+        DBG("### Buffer overflow: ", len, "received vs",
+            sockets[mux]->rx.free(), "available");
+      } else {
+        // DBG("### Got Data: ", len, "on", mux);
+      }
+      if (len > 0) { moveCharsFromStreamToFifo(mux, len); }
+      // TODO(SRGDamia1): deal with buffer overflow/missed characters
+      if (len_orig > sockets[mux]->available()) {
+        DBG("### Fewer characters received than expected: ",
+            sockets[mux]->available(), " vs ", len_orig);
+      }
+    }
+    return true;
+  }
+
+  bool onClosed(UrcContext& ctx) {
+    int8_t mux = ctx.seen.lineInt(6);  // "<mux>,CLOSED"
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = false;
+    }
+    DBG("### Closed: ", mux);
+    return true;
+  }
+
  public:
   Stream& stream;
 
@@ -91,6 +91,7 @@ class TinyGsmM95 : public TinyGsmModem<TinyGsmM95>,
 
    public:
     virtual int connect(const char* host, uint16_t port, int timeout_s) {
+      TINY_GSM_LOCK(at->commandLock());
       stop();
       TINY_GSM_YIELD();
       rx.clear();
@@ -100,6 +101,8 @@ class TinyGsmM95 : public TinyGsmModem<TinyGsmM95>,
     TINY_GSM_CLIENT_CONNECT_OVERRIDES
 
     void stop(uint32_t maxWaitMs) {
+      TINY_GSM_LOCK(at->commandLock());
+      endTx();
       uint32_t startMillis = millis();
       dumpModemBuffer(maxWaitMs);
       at->sendAT(GF("+QICLOSE="), mux);
@@ -135,6 +138,7 @@ class TinyGsmM95 : public TinyGsmModem<TinyGsmM95>,
 
     public:
       int connect(const char* host, uint16_t port, int timeout_s) override {
+        TINY_GSM_LOCK(at->commandLock());
         stop();
         TINY_GSM_YIELD();
         rx.clear();
@@ -472,12 +476,10 @@ class TinyGsmM95 : public TinyGsmModem<TinyGsmM95>,
       // that much there. In that case, make sure we make sure we re-set the
       // amount of data available.
       if (len < size) { sockets[mux]->sock_available = len; }
-      for (uint16_t i = 0; i < len; i++) {
-        moveCharFromStreamToFifo(mux);
-        sockets[mux]->sock_available--;
-        // ^^ One less character available after moving from modem's FIFO to our
-        // FIFO
-      }
+      moveCharsFromStreamToFifo(mux, len);
+      sockets[mux]->sock_available -= len;
+      // ^^ That many characters less available after moving from modem's FIFO
+      // to our FIFO
       waitResponse();  // ends with an OK
       // DBG("### READ:", len, "from", mux);
       return len;
@@ -498,12 +500,9 @@ class TinyGsmM95 : public TinyGsmModem<TinyGsmM95>,
 
     if (waitResponse(GF("+QISTATE:")) != 1) { return false; }
 
-    streamSkipUntil(',');                  // Skip mux
-    streamSkipUntil(',');                  // Skip socket type
-    streamSkipUntil(',');                  // Skip remote ip
-    streamSkipUntil(',');                  // Skip remote port
-    streamSkipUntil(',');                  // Skip local port
-    int8_t res = streamGetIntBefore(',');  // socket state
+    TinyGsmFields fields;
+    streamGetFields(fields);
+    int8_t res = fields.toInt(5);  // socket state
 
     waitResponse();
 
@@ -515,7 +514,6 @@ class TinyGsmM95 : public TinyGsmModem<TinyGsmM95>,
    * Utilities
    */
  public:
-  // TODO(vshymanskyy): Optimize this!
   int8_t waitResponse(uint32_t timeout_ms, String& data,
                       GsmConstStr r1 = GFP(GSM_OK),
                       GsmConstStr r2 = GFP(GSM_ERROR),
@@ -526,78 +524,7 @@ class TinyGsmM95 : public TinyGsmModem<TinyGsmM95>,
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    /*String r1s(r1); r1s.trim();
-    String r2s(r2); r2s.trim();
-    String r3s(r3); r3s.trim();
-    String r4s(r4); r4s.trim();
-    String r5s(r5); r5s.trim();
-    DBG("### ..:", r1s, ",", r2s, ",", r3s, ",", r4s, ",", r5s);*/
-    data.reserve(64);
-    uint8_t  index       = 0;
-    uint32_t startMillis = millis();
-    do {
-      TINY_GSM_YIELD();
-      while (stream.available() > 0) {
-        TINY_GSM_YIELD();
-        int8_t a = stream.read();
-        if (a <= 0) continue;  // Skip 0x00 bytes, just in case
-        data += static_cast<char>(a);
-        if (r1 && data.endsWith(r1)) {
-          index = 1;
-          goto finish;
-        } else if (r2 && data.endsWith(r2)) {
-          index = 2;
-          goto finish;
-        } else if (r3 && data.endsWith(r3)) {
-#if defined TINY_GSM_DEBUG
-          if (r3 == GFP(GSM_CME_ERROR)) {
-            streamSkipUntil('\n');  // Read out the error
-          }
-#endif
-          index = 3;
-          goto finish;
-        } else if (r4 && data.endsWith(r4)) {
-          index = 4;
-          goto finish;
-        } else if (r5 && data.endsWith(r5)) {
-          index = 5;
-          goto finish;
-        } else if (data.endsWith(GF(GSM_NL "+QIRDI:"))) {
-          streamSkipUntil(',');  // Skip the context
-          streamSkipUntil(',');  // Skip the role
-          int8_t mux = streamGetIntBefore('\n');
-          // DBG("### Got Data:", mux);
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-            // We have no way of knowing how much data actually came in, so
-            // we set the value to 1500, the maximum possible size.
-            sockets[mux]->sock_available = 1500;
-          }
-          data = "";
-        } else if (data.endsWith(GF("CLOSED" GSM_NL))) {
-          int8_t nl   = data.lastIndexOf(GSM_NL, data.length() - 8);
-          int8_t coma = data.indexOf(',', nl + 2);
-          int8_t mux  = data.substring(nl + 2, coma).toInt();
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-            sockets[mux]->sock_connected = false;
-          }
-          data = "";
-          DBG("### Closed: ", mux);
-        } else if (data.endsWith(GF("+QNITZ:"))) {
-          streamSkipUntil('\n');  // URC for time sync
-          data = "";
-          DBG("### Network time updated.");
-        }
-      }
-    } while (millis() - startMillis < timeout_ms);
-  finish:
-    if (!index) {
-      data.trim();
-      if (data.length()) { DBG("### Unhandled:", data); }
-      data = "";
-    }
-    // data.replace(GSM_NL, "/");
-    // DBG('<', index, '>', data);
-    return index;
+    return parseResponse(timeout_ms, &data, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(uint32_t timeout_ms, GsmConstStr r1 = GFP(GSM_OK),
@@ -609,8 +536,7 @@ class TinyGsmM95 : public TinyGsmModem<TinyGsmM95>,
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    String data;
-    return waitResponse(timeout_ms, data, r1, r2, r3, r4, r5);
+    return parseResponse(timeout_ms, NULL, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(GsmConstStr r1 = GFP(GSM_OK),
@@ -625,6 +551,49 @@ class TinyGsmM95 : public TinyGsmModem<TinyGsmM95>,
     return waitResponse(1000, r1, r2, r3, r4, r5);
   }
 
+ protected:
+  // URCs, matched anywhere in the modem's output
+  static UrcTable urcTable() {
+    static constexpr Urc urcs[] TINY_GSM_PROGMEM = {
+        {GSM_NL "+QIRDI:", &TinyGsmM95::onQiRdi},
+        {"CLOSED" GSM_NL, &TinyGsmM95::onClosed},
+        {"+QNITZ:", &TinyGsmM95::onQnitz},
+        {GSM_NL "+CREG:", &TinyGsmM95::onCreg},
+        {GSM_NL "+CGEV:", &TinyGsmM95::onBearerEvent},
+        {"", NULL}};
+    typedef TinyGsmTrie<TinyGsmTrieSize(urcs)> Trie;
+    static constexpr Trie trie TINY_GSM_PROGMEM = Trie::of(urcs);
+    return {urcs, trie.nodes};
+  }
+
+  bool onQiRdi(UrcContext&) {
+    streamSkipUntil(',');  // Skip the context
+    streamSkipUntil(',');  // Skip the role
+    int8_t mux = streamGetIntBefore('\n');
+    // DBG("### Got Data:", mux);
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      // We have no way of knowing how much data actually came in, so
+      // we set the value to 1500, the maximum possible size.
+      sockets[mux]->sock_available = 1500;
+    }
+    return true;
+  }
+
+  bool onClosed(UrcContext& ctx) {
+    int8_t mux = ctx.seen.lineInt(8);  // "<mux>, CLOSED"
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = false;
+    }
+    DBG("### Closed: ", mux);
+    return true;
+  }
+
+  bool onQnitz(UrcContext&) {
+    streamSkipUntil('\n');  // URC for time sync
+    DBG("### Network time updated.");
+    return true;
+  }
+
  public:
   Stream& stream;
 
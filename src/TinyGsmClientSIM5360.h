@@ -92,6 +92,7 @@ class TinyGsmSim5360 : public TinyGsmModem<TinyGsmSim5360>,
 
    public:
     virtual int connect(const char* host, uint16_t port, int timeout_s) {
+      TINY_GSM_LOCK(at->commandLock());
       stop();
       TINY_GSM_YIELD();
       rx.clear();
@@ -101,6 +102,8 @@ class TinyGsmSim5360 : public TinyGsmModem<TinyGsmSim5360>,
     TINY_GSM_CLIENT_CONNECT_OVERRIDES
 
     void stop(uint32_t maxWaitMs) {
+      TINY_GSM_LOCK(at->commandLock());
+      endTx();
       dumpModemBuffer(maxWaitMs);
       at->sendAT(GF("+CIPCLOSE="), mux);
       sock_connected = false;
@@ -132,6 +135,7 @@ class TinyGsmSim5360 : public TinyGsmModem<TinyGsmSim5360>,
 
    public:
     int connect(const char* host, uint16_t port, int timeout_s) override {
+      TINY_GSM_LOCK(at->commandLock());
       stop();
       TINY_GSM_YIELD();
       rx.clear();
@@ -261,6 +265,12 @@ class TinyGsmSim5360 : public TinyGsmModem<TinyGsmSim5360>,
     return (s == REG_OK_HOME || s == REG_OK_ROAMING);
   }
 
+  // Automatic +CSQ reports, on every change of the signal
+  bool signalReportsImpl(bool enable) {
+    sendAT(GF("+AUTOCSQ="), enable ? GF("1,1") : GF("0"));
+    return waitResponse() == 1;
+  }
+
  public:
   String getNetworkModes() {
     sendAT(GF("+CNMP=?"));
@@ -443,15 +453,13 @@ class TinyGsmSim5360 : public TinyGsmModem<TinyGsmSim5360>,
   uint16_t getBattVoltageImpl() {
     sendAT(GF("+CBC"));
     if (waitResponse(GF(GSM_NL "+CBC:")) != 1) { return 0; }
-    streamSkipUntil(',');  // Skip battery charge status
-    streamSkipUntil(',');  // Skip battery charge level
-    // get voltage in VOLTS
-    float voltage = streamGetFloatBefore('\n');
+    // <bcs>,<bcl>,<voltage in VOLTS>
+    TinyGsmFields fields;
+    streamGetFields(fields);
     // Wait for final OK
     waitResponse();
     // Return millivolts
-    uint16_t res = voltage * 1000;
-    return res;
+    return fields.toFixed(2, 3);
   }
 
   // SRGD Note:  Returns voltage in VOLTS instead of millivolts
@@ -459,11 +467,12 @@ class TinyGsmSim5360 : public TinyGsmModem<TinyGsmSim5360>,
                         uint16_t& milliVolts) {
     sendAT(GF("+CBC"));
     if (waitResponse(GF(GSM_NL "+CBC:")) != 1) { return false; }
-    chargeState = streamGetIntBefore(',');
-    percent     = streamGetIntBefore(',');
-    // get voltage in VOLTS
-    float voltage = streamGetFloatBefore('\n');
-    milliVolts    = voltage * 1000;
+    TinyGsmFields fields;
+    streamGetFields(fields);
+    chargeState = fields.toInt(0);
+    percent     = fields.toInt(1);
+    // voltage in VOLTS
+    milliVolts = fields.toFixed(2, 3);
     // Wait for final OK
     waitResponse();
     return true;
@@ -534,27 +543,12 @@ class TinyGsmSim5360 : public TinyGsmModem<TinyGsmSim5360>,
     //  ^^ Requested number of data bytes (1-1460 bytes)to be read
     int16_t len_confirmed = streamGetIntBefore('\n');
     // ^^ The data length which not read in the buffer
-    for (int i = 0; i < len_requested; i++) {
-      uint32_t startMillis = millis();
+    if (len_requested > 0) {
 #ifdef TINY_GSM_USE_HEX
-      while (stream.available() < 2 &&
-             (millis() - startMillis < sockets[mux]->_timeout)) {
-        TINY_GSM_YIELD();
-      }
-      char buf[4] = {
-          0,
-      };
-      buf[0] = stream.read();
-      buf[1] = stream.read();
-      char c = strtol(buf, NULL, 16);
+      moveHexFromStreamToFifo(mux, len_requested);
 #else
-      while (!stream.available() &&
-             (millis() - startMillis < sockets[mux]->_timeout)) {
-        TINY_GSM_YIELD();
-      }
-      char c = stream.read();
+      moveCharsFromStreamToFifo(mux, len_requested);
 #endif
-      sockets[mux]->rx.put(c);
     }
     // DBG("### READ:", len_requested, "from", mux);
     // sockets[mux]->sock_available = modemGetAvailable(mux);
@@ -582,9 +576,11 @@ class TinyGsmSim5360 : public TinyGsmModem<TinyGsmSim5360>,
     // Read the status of all sockets at once
     sendAT(GF("+CIPCLOSE?"));
     if (waitResponse(GF("+CIPCLOSE:")) != 1) { return false; }
+    // +CIPCLOSE:<link0_state>,<link1_state>,...,<link9_state>
+    TinyGsmFields fields;
+    streamGetFields(fields);
     for (int muxNo = 0; muxNo < TINY_GSM_MUX_COUNT; muxNo++) {
-      // +CIPCLOSE:<link0_state>,<link1_state>,...,<link9_state>
-      bool muxState = stream.parseInt();
+      bool muxState = fields.toInt(muxNo, 0);
       if (sockets[muxNo]) { sockets[muxNo]->sock_connected = muxState; }
     }
     waitResponse();  // Should be an OK at the end
@@ -596,7 +592,6 @@ class TinyGsmSim5360 : public TinyGsmModem<TinyGsmSim5360>,
    * Utilities
    */
  public:
-  // TODO(vshymanskyy): Optimize this!
   int8_t waitResponse(uint32_t timeout_ms, String& data,
                       GsmConstStr r1 = GFP(GSM_OK),
                       GsmConstStr r2 = GFP(GSM_ERROR),
@@ -607,89 +602,7 @@ class TinyGsmSim5360 : public TinyGsmModem<TinyGsmSim5360>,
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    /*String r1s(r1); r1s.trim();
-    String r2s(r2); r2s.trim();
-    String r3s(r3); r3s.trim();
-    String r4s(r4); r4s.trim();
-    String r5s(r5); r5s.trim();
-    DBG("### ..:", r1s, ",", r2s, ",", r3s, ",", r4s, ",", r5s);*/
-    data.reserve(64);
-    uint8_t  index       = 0;
-    uint32_t startMillis = millis();
-    do {
-      TINY_GSM_YIELD();
-      while (stream.available() > 0) {
-        TINY_GSM_YIELD();
-        int8_t a = stream.read();
-        if (a <= 0) continue;  // Skip 0x00 bytes, just in case
-        data += static_cast<char>(a);
-        if (r1 && data.endsWith(r1)) {
-          index = 1;
-          goto finish;
-        } else if (r2 && data.endsWith(r2)) {
-          index = 2;
-          goto finish;
-        } else if (r3 && data.endsWith(r3)) {
-#if defined TINY_GSM_DEBUG
-          if (r3 == GFP(GSM_CME_ERROR)) {
-            streamSkipUntil('\n');  // Read out the error
-          }
-#endif
-          index = 3;
-          goto finish;
-        } else if (r4 && data.endsWith(r4)) {
-          index = 4;
-          goto finish;
-        } else if (r5 && data.endsWith(r5)) {
-          index = 5;
-          goto finish;
-        } else if (data.endsWith(GF(GSM_NL "+CIPRXGET:"))) {
-          int8_t mode = streamGetIntBefore(',');
-          if (mode == 1) {
-            int8_t mux = streamGetIntBefore('\n');
-            if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-              sockets[mux]->got_data = true;
-            }
-            data = "";
-            // DBG("### Got Data:", mux);
-          } else {
-            data += mode;
-          }
-        } else if (data.endsWith(GF(GSM_NL "+RECEIVE:"))) {
-          int8_t  mux = streamGetIntBefore(',');
-          int16_t len = streamGetIntBefore('\n');
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-            sockets[mux]->got_data = true;
-            if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
-          }
-          data = "";
-          // DBG("### Got Data:", len, "on", mux);
-        } else if (data.endsWith(GF("+IPCLOSE:"))) {
-          int8_t mux = streamGetIntBefore(',');
-          streamSkipUntil('\n');  // Skip the reason code
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-            sockets[mux]->sock_connected = false;
-          }
-          data = "";
-          DBG("### Closed: ", mux);
-        } else if (data.endsWith(GF("+CIPEVENT:"))) {
-          // Need to close all open sockets and release the network library.
-          // User will then need to reconnect.
-          DBG("### Network error!");
-          if (!isGprsConnected()) { gprsDisconnect(); }
-          data = "";
-        }
-      }
-    } while (millis() - startMillis < timeout_ms);
-  finish:
-    if (!index) {
-      data.trim();
-      if (data.length()) { DBG("### Unhandled:", data); }
-      data = "";
-    }
-    // data.replace(GSM_NL, "/");
-    // DBG('<', index, '>', data);
-    return index;
+    return parseResponse(timeout_ms, &data, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(uint32_t timeout_ms, GsmConstStr r1 = GFP(GSM_OK),
@@ -701,8 +614,7 @@ class TinyGsmSim5360 : public TinyGsmModem<TinyGsmSim5360>,
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    String data;
-    return waitResponse(timeout_ms, data, r1, r2, r3, r4, r5);
+    return parseResponse(timeout_ms, NULL, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(GsmConstStr r1 = GFP(GSM_OK),
@@ -717,6 +629,67 @@ class TinyGsmSim5360 : public TinyGsmModem<TinyGsmSim5360>,
     return waitResponse(1000, r1, r2, r3, r4, r5);
   }
 
+ protected:
+  // URCs, matched anywhere in the modem's output
+  static UrcTable urcTable() {
+    static constexpr Urc urcs[] TINY_GSM_PROGMEM = {
+        {GSM_NL "+CIPRXGET:", &TinyGsmSim5360::onCipRxGet},
+        {GSM_NL "+RECEIVE:", &TinyGsmSim5360::onReceive},
+        {"+IPCLOSE:", &TinyGsmSim5360::onIpClose},
+        {"+CIPEVENT:", &TinyGsmSim5360::onCipEvent},
+        {GSM_NL "+CGREG:", &TinyGsmSim5360::onCgreg},
+        {GSM_NL "+CGEV:", &TinyGsmSim5360::onBearerEvent},
+        {GSM_NL "+PDP: DEACT", &TinyGsmSim5360::onBearerEvent},
+        {GSM_NL "+CSQ:", &TinyGsmSim5360::onSignalReport},
+        {"", NULL}};
+    typedef TinyGsmTrie<TinyGsmTrieSize(urcs)> Trie;
+    static constexpr Trie trie TINY_GSM_PROGMEM = Trie::of(urcs);
+    return {urcs, trie.nodes};
+  }
+
+  bool onCipRxGet(UrcContext& ctx) {
+    int8_t mode = streamGetIntBefore(',');
+    if (mode != 1) {
+      // The answer to a +CIPRXGET=<mode> command, not a notification
+      if (ctx.data) { *ctx.data += mode; }
+      return false;
+    }
+    int8_t mux = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->got_data = true;
+    }
+    // DBG("### Got Data:", mux);
+    return true;
+  }
+
+  bool onReceive(UrcContext&) {
+    int8_t  mux = streamGetIntBefore(',');
+    int16_t len = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->got_data = true;
+      if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
+    }
+    // DBG("### Got Data:", len, "on", mux);
+    return true;
+  }
+
+  bool onIpClose(UrcContext&) {
+    int8_t mux = streamGetIntBefore(',');
+    streamSkipUntil('\n');  // Skip the reason code
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = false;
+    }
+    DBG("### Closed: ", mux);
+    return true;
+  }
+
+  bool onCipEvent(UrcContext&) {
+    // User will then need to reconnect.
+    DBG("### Network error!");
+    if (!isGprsConnected()) { gprsDisconnect(); }
+    return true;
+  }
+
  public:
   Stream& stream;
 
@@ -89,6 +89,7 @@ class TinyGsmSim7000 : public TinyGsmModem<TinyGsmSim7000>,
 
    public:
     virtual int connect(const char* host, uint16_t port, int timeout_s) {
+      TINY_GSM_LOCK(at->commandLock());
       stop();
       TINY_GSM_YIELD();
       rx.clear();
@@ -97,7 +98,19 @@ class TinyGsmSim7000 : public TinyGsmModem<TinyGsmSim7000>,
     }
     TINY_GSM_CLIENT_CONNECT_OVERRIDES
 
+    // Connects in the background; host has to outlive the request
+    bool connect(TinyGsmRequest& req, const char* host, uint16_t port,
+                 int timeout_s = 75) {
+      TINY_GSM_LOCK(at->commandLock());
+      stop();
+      TINY_GSM_YIELD();
+      rx.clear();
+      return at->connectRequest(req, host, port, mux, false, timeout_s);
+    }
+
     void stop(uint32_t maxWaitMs) {
+      TINY_GSM_LOCK(at->commandLock());
+      endTx();
       dumpModemBuffer(maxWaitMs);
       at->sendAT(GF("+CACLOSE="), mux);
       sock_connected = false;
@@ -112,6 +125,63 @@ class TinyGsmSim7000 : public TinyGsmModem<TinyGsmSim7000>,
      */
 
     String remoteIP() TINY_GSM_ATTR_NOT_IMPLEMENTED;
+
+    // Streams a large upload through the modem's transparent mode, with none
+    // of the prompt and answer write() waits for on every chunk:
+    //
+    //   {
+    //     GsmClientSim7000::BulkSend bulk(client);
+    //     if (!bulk) { ... }
+    //     bulk.write(buf, len);
+    //   }  // back to AT commands here
+    //
+    // With TINY_GSM_THREADED a session holds the command lock, and
+    // maintain() asks nothing while it is open.  A command made meanwhile
+    // (e.g. by another client) ends it with +++ first, and write() then
+    // returns 0.  What the server sends
+    // meanwhile goes to the client's receive buffer while it has room (see
+    // getRxLost()).
+    class BulkSend {
+     public:
+      explicit BulkSend(GsmClientSim7000& client)
+          : client(client),
+#if defined TINY_GSM_THREADED
+            lock(client.at->commandLock()),
+#endif
+            active(false) {
+        client.endTx();
+        active = client.at->modemBulkBegin(client.mux);
+      }
+      ~BulkSend() {
+        end();
+      }
+
+      explicit operator bool() const {
+        return active;
+      }
+
+      size_t write(const uint8_t* buf, size_t size) {
+        if (!active) { return 0; }
+        return client.at->modemBulkWrite(buf, size, client.mux);
+      }
+
+      // Leaves transparent mode; true if the modem went back to commands
+      bool end() {
+        if (!active) { return false; }
+        active = false;
+        return client.at->modemBulkEnd();
+      }
+
+     private:
+      GsmClientSim7000& client;
+#if defined TINY_GSM_THREADED
+      TinyGsmLock lock;
+#endif
+      bool active;
+
+      BulkSend(const BulkSend&);
+      BulkSend& operator=(const BulkSend&);
+    };
   };
 
   /*
@@ -131,6 +201,7 @@ class TinyGsmSim7000 : public TinyGsmModem<TinyGsmSim7000>,
     }
 
     int connect(const char* host, uint16_t port, int timeout_s) override {
+      TINY_GSM_LOCK(at->commandLock());
       stop();
       TINY_GSM_YIELD();
       rx.clear();
@@ -138,6 +209,15 @@ class TinyGsmSim7000 : public TinyGsmModem<TinyGsmSim7000>,
       return sock_connected;
     }
     TINY_GSM_CLIENT_CONNECT_OVERRIDES
+
+    bool connect(TinyGsmRequest& req, const char* host, uint16_t port,
+                 int timeout_s = 75) {
+      TINY_GSM_LOCK(at->commandLock());
+      stop();
+      TINY_GSM_YIELD();
+      rx.clear();
+      return at->connectRequest(req, host, port, mux, true, timeout_s);
+    }
   };
 
 public:
@@ -204,27 +284,23 @@ public:
     DBG(GF("### TinyGSM Version:"), TINYGSM_VERSION);
     DBG(GF("### TinyGSM Compiled Module:  TinyGsmClientSIM7000"));
 
+    forgetProfiles();
     if (!testAT()) { return false; }
 
-    sendAT(GF("E0"));  // Echo Off
-    if (waitResponse() != 1) { return false; }
-
+    Batch batch(*this);
+    batch.add(GF("E0"));  // Echo Off
 #ifdef TINY_GSM_DEBUG
-    sendAT(GF("+CMEE=2"));  // turn on verbose error codes
+    batch.add(GF("+CMEE=2")).optional();  // turn on verbose error codes
 #else
-    sendAT(GF("+CMEE=0"));  // turn off error codes
+    batch.add(GF("+CMEE=0")).optional();  // turn off error codes
 #endif
-    waitResponse();
-
-    DBG(GF("### Modem:"), getModemName());
-
     // Enable Local Time Stamp for getting network time
-    sendAT(GF("+CLTS=1"));
-    if (waitResponse(10000L) != 1) { return false; }
-
+    batch.add(GF("+CLTS=1")).timeout(10000L);
     // Enable battery checks
-    sendAT(GF("+CBATCHK=1"));
-    if (waitResponse() != 1) { return false; }
+    batch.add(GF("+CBATCHK=1"));
+    if (!batch.done()) { return false; }
+
+    DBG(GF("### Modem:"), getModemName());
 
     SimStatus ret = getSimStatus();
     // if the sim isn't ready and a pin has been provided, try to unlock the sim
@@ -326,6 +402,12 @@ public:
     return (s == REG_OK_HOME || s == REG_OK_ROAMING);
   }
 
+  // Automatic +CSQ reports, on every change of the signal
+  bool signalReportsImpl(bool enable) {
+    sendAT(GF("+AUTOCSQ="), enable ? GF("1,1") : GF("0"));
+    return waitResponse() == 1;
+  }
+
  public:
   String getNetworkModes() {
     // Get the help string, not the setting value
@@ -408,54 +490,44 @@ public:
                        const char* pwd = NULL) {
     gprsDisconnect();
 
+    // The settings go out back to back; the commands that go to the network
+    // are answered before the next is sent
+    Batch batch(*this);
     // Open data connection
-    sendAT(GF("+CNACT=1,\""), apn, GF("\""));
-    if (waitResponse(60000L) != 1) { return false; }
+    batch.add(GF("+CNACT=1,\""), apn, GF("\"")).timeout(60000L).wait();
 
     // Set the Bearer for the IP
-    sendAT(GF(
-        "+SAPBR=3,1,\"Contype\",\"GPRS\""));  // Set the connection type to GPRS
-    waitResponse();
-
-    sendAT(GF("+SAPBR=3,1,\"APN\",\""), apn, '"');  // Set the APN
-    waitResponse();
-
+    batch.add(GF("+SAPBR=3,1,\"Contype\",\"GPRS\""))  // connection type GPRS
+        .optional();
+    batch.add(GF("+SAPBR=3,1,\"APN\",\""), apn, '"')  // Set the APN
+        .optional();
     if (user && strlen(user) > 0) {
-      sendAT(GF("+SAPBR=3,1,\"USER\",\""), user, '"');  // Set the user name
-      waitResponse();
+      batch.add(GF("+SAPBR=3,1,\"USER\",\""), user, '"')  // Set the user name
+          .optional();
     }
     if (pwd && strlen(pwd) > 0) {
-      sendAT(GF("+SAPBR=3,1,\"PWD\",\""), pwd, '"');  // Set the password
-      waitResponse();
+      batch.add(GF("+SAPBR=3,1,\"PWD\",\""), pwd, '"')  // Set the password
+          .optional();
     }
 
     // Define the PDP context
-    sendAT(GF("+CGDCONT=1,\"IP\",\""), apn, '"');
-    waitResponse();
+    batch.add(GF("+CGDCONT=1,\"IP\",\""), apn, '"').optional();
 
     // Activate the PDP context
-    sendAT(GF("+CGACT=1,1"));
-    waitResponse(60000L);
+    batch.add(GF("+CGACT=1,1")).timeout(60000L).optional().wait();
 
     // Open the definied GPRS bearer context
-    sendAT(GF("+SAPBR=1,1"));
-    waitResponse(85000L);
+    batch.add(GF("+SAPBR=1,1")).timeout(85000L).optional().wait();
     // Query the GPRS bearer context status
-    sendAT(GF("+SAPBR=2,1"));
-    if (waitResponse(30000L) != 1) { return false; }
+    batch.add(GF("+SAPBR=2,1")).timeout(30000L);
 
     // Attach to GPRS
-    sendAT(GF("+CGATT=1"));
-    if (waitResponse(60000L) != 1) { return false; }
+    batch.add(GF("+CGATT=1")).timeout(60000L).wait();
 
     // Check data connection
+    batch.add(GF("+CNACT?")).expect(GF(GSM_NL "+CNACT: 1,"));
 
-    sendAT(GF("+CNACT?"));
-    if (waitResponse(GF(GSM_NL "+CNACT:")) != 1) { return false; }
-    int res = streamGetIntBefore(',');
-    waitResponse();
-
-    return res == 1;
+    return batch.done();
   }
 
   bool gprsDisconnectImpl() {
@@ -525,75 +597,34 @@ public:
     sendAT(GF("+CGNSINF"));
     if (waitResponse(10000L, GF(GSM_NL "+CGNSINF:")) != 1) { return false; }
 
-    streamSkipUntil(',');                // GNSS run status
-    if (streamGetIntBefore(',') == 1) {  // fix status
-      // init variables
-      float ilat         = 0;
-      float ilon         = 0;
-      float ispeed       = 0;
-      float ialt         = 0;
-      int   ivsat        = 0;
-      int   iusat        = 0;
-      float iaccuracy    = 0;
-      int   iyear        = 0;
-      int   imonth       = 0;
-      int   iday         = 0;
-      int   ihour        = 0;
-      int   imin         = 0;
-      float secondWithSS = 0;
-
-      // UTC date & Time
-      iyear  = streamGetIntLength(4);  // Four digit year
-      imonth = streamGetIntLength(2);  // Two digit month
-      iday   = streamGetIntLength(2);  // Two digit day
-      ihour  = streamGetIntLength(2);  // Two digit hour
-      imin   = streamGetIntLength(2);  // Two digit minute
-      secondWithSS =
-          streamGetFloatBefore(',');  // 6 digit second with subseconds
-
-      ilat   = streamGetFloatBefore(',');  // Latitude
-      ilon   = streamGetFloatBefore(',');  // Longitude
-      ialt   = streamGetFloatBefore(',');  // MSL Altitude. Unit is meters
-      ispeed = streamGetFloatBefore(',');  // Speed Over Ground. Unit is knots.
-      streamSkipUntil(',');                // Course Over Ground. Degrees.
-      streamSkipUntil(',');                // Fix Mode
-      streamSkipUntil(',');                // Reserved1
-      iaccuracy =
-          streamGetFloatBefore(',');    // Horizontal Dilution Of Precision
-      streamSkipUntil(',');             // Position Dilution Of Precision
-      streamSkipUntil(',');             // Vertical Dilution Of Precision
-      streamSkipUntil(',');             // Reserved2
-      ivsat = streamGetIntBefore(',');  // GNSS Satellites in View
-      iusat = streamGetIntBefore(',');  // GNSS Satellites Used
-      streamSkipUntil(',');             // GLONASS Satellites Used
-      streamSkipUntil(',');             // Reserved3
-      streamSkipUntil(',');             // C/N0 max
-      streamSkipUntil(',');             // HPA
-      streamSkipUntil('\n');            // VPA
-
-      // Set pointers
-      if (lat != NULL) *lat = ilat;
-      if (lon != NULL) *lon = ilon;
-      if (speed != NULL) *speed = ispeed;
-      if (alt != NULL) *alt = ialt;
-      if (vsat != NULL) *vsat = ivsat;
-      if (usat != NULL) *usat = iusat;
-      if (accuracy != NULL) *accuracy = iaccuracy;
-      if (iyear < 2000) iyear += 2000;
-      if (year != NULL) *year = iyear;
-      if (month != NULL) *month = imonth;
-      if (day != NULL) *day = iday;
-      if (hour != NULL) *hour = ihour;
-      if (minute != NULL) *minute = imin;
-      if (second != NULL) *second = static_cast<int>(secondWithSS);
-
-      waitResponse();
-      return true;
-    }
-
-    streamSkipUntil('\n');  // toss the row of commas
+    // Run status, fix status, UTC date & time, latitude, longitude, MSL
+    // altitude (m), speed over ground (knots), course over ground, fix mode,
+    // reserved, HDOP, PDOP, VDOP, reserved, GNSS satellites in view, GNSS
+    // satellites used, GLONASS satellites used, reserved, C/N0 max, HPA, VPA
+    TinyGsmFields fields;
+    streamGetFields(fields);
     waitResponse();
-    return false;
+    if (fields.toInt(1) != 1) { return false; }  // no fix, a row of commas
+
+    // UTC date & time as yyyyMMddhhmmss.sss
+    int iyear = fields.digits(2, 0, 4);
+    if (iyear < 2000) iyear += 2000;
+
+    // Set pointers
+    if (lat != NULL) *lat = fields.toFloat(3);
+    if (lon != NULL) *lon = fields.toFloat(4);
+    if (speed != NULL) *speed = fields.toFloat(6);
+    if (alt != NULL) *alt = fields.toFloat(5);
+    if (vsat != NULL) *vsat = fields.toInt(14);
+    if (usat != NULL) *usat = fields.toInt(15);
+    if (accuracy != NULL) *accuracy = fields.toFloat(10);  // HDOP
+    if (year != NULL) *year = iyear;
+    if (month != NULL) *month = fields.digits(2, 4, 2);
+    if (day != NULL) *day = fields.digits(2, 6, 2);
+    if (hour != NULL) *hour = fields.digits(2, 8, 2);
+    if (minute != NULL) *minute = fields.digits(2, 10, 2);
+    if (second != NULL) *second = fields.digits(2, 12, 2);
+    return true;
   }
 
   /*
@@ -613,43 +644,105 @@ public:
  protected:
   bool modemConnect(const char* host, uint16_t port, uint8_t mux,
                     bool ssl = false, int timeout_s = 75) {
-    uint32_t timeout_ms = ((uint32_t)timeout_s) * 1000;
+    TinyGsmRequest req;
+    connectRequest(req, host, port, mux, ssl, timeout_s);
+    return runRequest(req);
+  }
 
-    sendAT(GF("+CACID="), mux);
-    if (waitResponse(timeout_ms) != 1) return false;
+  bool connectRequest(TinyGsmRequest& req, const char* host, uint16_t port,
+                      uint8_t mux, bool ssl, int timeout_s) {
+    req.str[0]     = host;
+    req.num[0]     = port;
+    req.num[1]     = mux;
+    req.num[2]     = ssl;
+    req.timeout_ms = ((uint32_t)timeout_s) * 1000;
+    return startRequest(req, this, connectStep);
+  }
 
-    if (ssl) {
-      sendAT(GF("+CSSLCFG=\"sslversion\",0,3"));  // TLS 1.2
-      if (waitResponse() != 1) return false;
+  static void connectStep(void* owner, TinyGsmRequest& req) {
+    TinyGsmSim7000* at   = static_cast<TinyGsmSim7000*>(owner);
+    const char*     host = req.str[0];
+    uint8_t         mux  = req.num[1];
+    switch (req.stage++) {
+      case 0: {
+        // The settings are answered right away; only the open takes long.
+        // Those the last connect left as wanted are not sent again.
+        ConnectProfile& profile = at->profiles[mux];
+        const String&   cert    = at->certificates[mux];
+        bool            ssl     = req.num[2] != 0;
+        Batch           batch(*at);
+        if (at->profileCid != mux) {
+          batch.add(GF("+CACID="), mux).timeout(req.timeout_ms);
+        }
 
-      sendAT(GF("+CSSLCFG=\"ctxindex\",0"));
-      if (waitResponse() != 1) return false;
+        if (ssl) {
+          if (!at->profileSslCtx) {
+            batch.add(GF("+CSSLCFG=\"sslversion\",0,3"));  // TLS 1.2
+            batch.add(GF("+CSSLCFG=\"ctxindex\",0"));
+          }
+          if (cert != "" && cert != profile.cacert) {
+            batch.add(GF("+CASSLCFG="), mux, ",CACERT,\"", cert.c_str(),
+                      "\"");
+          }
+        }
 
-      if (certificates[mux] != "")
-      {
-        sendAT(GF("+CASSLCFG="), mux, ",CACERT,\"", certificates[mux].c_str(),"\"");
-        if (waitResponse() != 1) return false;
+        // These may fail; each is kept as set only if the modem took it
+        bool sslSet      = profile.ssl == ssl;
+        bool protocolSet = profile.protocol;
+        bool sniSet      = profile.sni == host;
+        if (!sslSet) {
+          batch.add(GF("+CASSLCFG="), mux, ',', GF("ssl,"), ssl)
+              .optional()
+              .result(&sslSet);
+        }
+        if (!protocolSet) {
+          batch.add(GF("+CASSLCFG="), mux, ',', GF("protocol,0"))
+              .optional()
+              .result(&protocolSet);
+        }
+        if (!sniSet) {
+          batch
+              .add(GF("+CSSLCFG=\"sni\","), mux, ',', GF("\""), host,
+                   GF("\""))
+              .optional()
+              .result(&sniSet);
+        }
+        if (!batch.done()) {
+          // Some of it may have been set; send it all next time
+          profile        = ConnectProfile();
+          at->profileCid = -1;
+          req.finish(REQUEST_FAILED);
+          break;
+        }
+        at->profileCid = mux;
+        if (ssl) {
+          at->profileSslCtx = true;
+          if (cert != "") { profile.cacert = cert; }
+        }
+        profile.ssl      = sslSet ? ssl : -1;
+        profile.protocol = protocolSet;
+        profile.sni      = sniSet ? host : "";
+
+        at->sendAT(GF("+CAOPEN="), mux, ',', GF("\""), host, GF("\","),
+                   (uint16_t)req.num[0]);
+        at->expectAnswer(req, req.timeout_ms, GF(GSM_NL "+CAOPEN:"));
+        break;
+      }
+      case 1:
+        if (req.answer != 1) {
+          req.finishByAnswer();
+          break;
+        }
+        at->streamSkipUntil(',');                    // Skip mux
+        req.num[0] = at->streamGetIntBefore('\n');  // the port is done with
+        at->expectAnswer(req, 1000L);
+        break;
+      default: {
+        bool connected = req.num[0] == 0;
+        if (at->sockets[mux]) { at->sockets[mux]->sock_connected = connected; }
+        req.finish(connected ? REQUEST_OK : REQUEST_FAILED);
       }
     }
-
-    sendAT(GF("+CASSLCFG="), mux, ',', GF("ssl,"), ssl);
-    waitResponse();
-
-    sendAT(GF("+CASSLCFG="), mux, ',', GF("protocol,0"));
-    waitResponse();
-
-    sendAT(GF("+CSSLCFG=\"sni\","), mux, ',', GF("\""), host, GF("\""));
-    waitResponse();
-
-    sendAT(GF("+CAOPEN="), mux, ',', GF("\""), host, GF("\","), port);
-
-    if (waitResponse(timeout_ms, GF(GSM_NL "+CAOPEN:")) != 1) { return 0; }
-    streamSkipUntil(',');  // Skip mux
-
-    int8_t res = streamGetIntBefore('\n');
-    waitResponse();
-
-    return 0 == res;
   }
 
   int16_t modemSend(const void* buff, size_t len, uint8_t mux) {
@@ -671,6 +764,45 @@ public:
     return streamGetIntBefore('\n');
   }
 
+  // Transparent mode: everything written goes out on the connection, and
+  // everything the modem sends is what arrived on it
+  bool modemBulkBegin(uint8_t mux) {
+    if (!sockets[mux] || !sockets[mux]->sock_connected) { return false; }
+    takeUrcs();
+    sendAT(GF("+CASWITCH="), mux, GF(",1"));
+    if (waitResponse(GF("CONNECT" GSM_NL)) != 1) { return false; }
+    bulkMux    = mux;
+    bulkLastTx = millis();
+    return true;
+  }
+
+  size_t modemBulkWrite(const uint8_t* buf, size_t len, uint8_t mux) {
+    if (bulkMux != mux) { return 0; }  // a command ended the session
+    size_t done = stream.write(buf, len);
+    bulkLastTx  = millis();
+    takeDataModeBytes(sockets[mux]);
+    return done;
+  }
+
+  // Back to commands, unless a command has done so already; if the modem
+  // does not take the +++ the session stays, for the next command to try
+  bool modemBulkEnd() {
+    int8_t mux = bulkMux;
+    if (mux < 0) { return true; }
+    bulkMux = -1;  // for the answer to be read
+    if (escapeDataMode(sockets[mux], bulkLastTx)) { return true; }
+    bulkMux    = mux;
+    bulkLastTx = millis();
+    return false;
+  }
+
+  bool inDataModeImpl() {
+    return bulkMux >= 0;
+  }
+  void leaveDataModeImpl() {
+    modemBulkEnd();
+  }
+
   size_t modemRead(size_t size, uint8_t mux) {
     if (!sockets[mux]) return 0;
 
@@ -695,15 +827,7 @@ public:
         return 0;
     }
 
-    for (int i = 0; i < len_confirmed; i++) {
-      uint32_t startMillis = millis();
-      while (!stream.available() &&
-            (millis() - startMillis < sockets[mux]->_timeout)) {
-        TINY_GSM_YIELD();
-      }
-      char c = stream.read();
-      sockets[mux]->rx.put(c);
-    }
+    moveCharsFromStreamToFifo(mux, len_confirmed);
     // DBG("### READ:", len_requested, "from", mux);
     // sockets[mux]->sock_available = modemGetAvailable(mux);
     auto diff = int64_t(size) - int64_t(len_confirmed);
@@ -740,37 +864,81 @@ public:
 
   bool modemGetConnected(uint8_t mux) {
     sendAT(GF("+CASTATE?"));
-    int8_t readMux = -1;
-    while (readMux != mux) {
-      if (waitResponse(3000, GF("+CASTATE:"),GF(GSM_OK)) != 1) {
-          return 0;
+    // +CASTATE: <cid>,<state>, one line per open connection
+    TinyGsmFields fields;
+    do {
+      if (waitResponse(3000, GF("+CASTATE:"), GF(GSM_OK)) != 1) { return 0; }
+      streamGetFields(fields);
+    } while (fields.toInt(0) != mux);
+    waitResponse();
+    return 1 == fields.toInt(1);
+  }
+
+  // +CARECV? lists what every open connection holds, so one query refreshes
+  // all sockets; one +CASTATE? then settles the sockets whose state it
+  // contradicts
+  void modemGetAvailableAll() {
+    bool listed[TINY_GSM_MUX_COUNT] = {};
+    sendAT(GF("+CARECV?"));
+    // +CARECV: <cid>,<recvlen>, one line per open connection
+    while (waitResponse(GF("+CARECV:"), GFP(GSM_OK), GFP(GSM_ERROR)) == 1) {
+      int8_t  mux = streamGetIntBefore(',');
+      int16_t len = streamGetIntBefore('\n');
+      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+        sockets[mux]->sock_available = len > 0 ? len : 0;
+        listed[mux]                  = true;
       }
-      readMux = streamGetIntBefore(',');
     }
-    int8_t res = streamGetIntBefore('\n');
-    waitResponse();
-    return 1 == res;
+
+    bool check = false;
+    for (int mux = 0; mux < TINY_GSM_MUX_COUNT; mux++) {
+      GsmClientSim7000* sock = sockets[mux];
+      if (!sock) continue;
+      // The ones nobody asked about were checked along the way
+      if (!sock->got_data) { sock->prev_check = millis(); }
+      sock->got_data = false;
+      if (listed[mux] != sock->sock_connected) { check = true; }
+    }
+    if (check) { modemGetConnectedAll(); }
+    for (int mux = 0; mux < TINY_GSM_MUX_COUNT; mux++) {
+      GsmClientSim7000* sock = sockets[mux];
+      if (sock && !sock->sock_connected) { sock->sock_available = 0; }
+    }
+  }
+
+  void modemGetConnectedAll() {
+    bool open[TINY_GSM_MUX_COUNT] = {};
+    sendAT(GF("+CASTATE?"));
+    // +CASTATE: <cid>,<state>, one line per open connection
+    TinyGsmFields fields;
+    int8_t        res;
+    while ((res = waitResponse(3000, GF("+CASTATE:"), GFP(GSM_OK),
+                               GFP(GSM_ERROR))) == 1) {
+      streamGetFields(fields);
+      int mux = fields.toInt(0, -1);
+      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT) {
+        open[mux] = 1 == fields.toInt(1);
+      }
+    }
+    // Without a full list, keep what is known
+    if (res != 2) return;
+    for (int mux = 0; mux < TINY_GSM_MUX_COUNT; mux++) {
+      if (sockets[mux]) { sockets[mux]->sock_connected = open[mux]; }
+    }
   }
 
  public:
   bool modemGetConnected(const char* host, uint16_t port, uint8_t mux) {
     sendAT(GF("+CAOPEN?"));
-    int8_t readMux = -1;
-    while (readMux != mux) {
+    // +CAOPEN: <cid>,"<host>",<port>
+    TinyGsmFields fields;
+    do {
       if (waitResponse(GF("+CAOPEN:")) != 1) return 0;
-      readMux = streamGetIntBefore(',');
-    }
-    streamSkipUntil('\"');
-
-    size_t hostLen = strlen(host);
-
-    char buffer[hostLen];
-    stream.readBytesUntil('\"', buffer, hostLen);
-    streamSkipUntil(',');
-    uint16_t connectedPort = streamGetIntBefore('\n');
+      streamGetFields(fields);
+    } while (fields.toInt(0) != mux);
     waitResponse();
-    bool samePort                = connectedPort == port;
-    bool sameHost                = memcmp(buffer, host, hostLen) == 0;
+    bool samePort                = fields.toInt(2) == port;
+    bool sameHost                = strcmp(fields.str(1), host) == 0;
     sockets[mux]->sock_connected = sameHost && samePort;
 
     return sockets[mux]->sock_connected;
@@ -780,7 +948,6 @@ public:
    * Utilities
    */
  public:
-  // TODO(vshymanskyy): Optimize this!
   int8_t waitResponse(uint32_t timeout_ms, String& data,
                       GsmConstStr r1 = GFP(GSM_OK),
                       GsmConstStr r2 = GFP(GSM_ERROR),
@@ -791,126 +958,7 @@ public:
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    /*String r1s(r1); r1s.trim();
-    String r2s(r2); r2s.trim();
-    String r3s(r3); r3s.trim();
-    String r4s(r4); r4s.trim();
-    String r5s(r5); r5s.trim();
-    DBG("### ..:", r1s, ",", r2s, ",", r3s, ",", r4s, ",", r5s);*/
-    data.reserve(64);
-    uint8_t  index       = 0;
-    uint32_t startMillis = millis();
-    do {
-      TINY_GSM_YIELD();
-      while (stream.available() > 0) {
-        TINY_GSM_YIELD();
-        int8_t a = stream.read();
-        if (a <= 0) continue;  // Skip 0x00 bytes, just in case
-        data += static_cast<char>(a);
-        if (r1 && data.endsWith(r1)) {
-          index = 1;
-          goto finish;
-        } else if (r2 && data.endsWith(r2)) {
-          index = 2;
-          goto finish;
-        } else if (r3 && data.endsWith(r3)) {
-#if defined TINY_GSM_DEBUG
-          if (r3 == GFP(GSM_CME_ERROR)) {
-            streamSkipUntil('\n');  // Read out the error
-          }
-#endif
-          index = 3;
-          goto finish;
-        } else if (r4 && data.endsWith(r4)) {
-          index = 4;
-          goto finish;
-        } else if (r5 && data.endsWith(r5)) {
-          index = 5;
-          goto finish;
-        } else if (data.endsWith(GF(GSM_NL "+CIPRXGET:"))) {
-          int8_t mode = streamGetIntBefore(',');
-          if (mode == 1) {
-            int8_t mux = streamGetIntBefore('\n');
-            if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-              sockets[mux]->got_data = true;
-            }
-            data = "";
-            // DBG("### Got Data:", mux);
-          } else {
-            data += mode;
-          }
-        } else if (data.endsWith(GF(GSM_NL "+CARECV:"))) {
-          int8_t mux = streamGetIntBefore(',');
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-            sockets[mux]->got_data = true;
-          }
-          data = "";
-          // DBG("### Got Data:", mux);
-        } else if (data.endsWith(GF(GSM_NL "+CADATAIND:"))) {
-          int8_t mux = streamGetIntBefore('\n');
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-            sockets[mux]->got_data = true;
-          }
-          data = "";
-          // DBG("### Got Data:", mux);
-        } else if (data.endsWith(GF(GSM_NL "+CASTATE:"))) {
-          int8_t mux = streamGetIntBefore(',');
-          int8_t state = streamGetIntBefore('\n');
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-              if (state != 1)
-              {
-                sockets[mux]->sock_connected = false;
-                DBG("### Closed: ", mux);
-              }
-          }
-          data = "";
-        } else if (data.endsWith(GF(GSM_NL "+RECEIVE:"))) {
-          int8_t  mux = streamGetIntBefore(',');
-          int16_t len = streamGetIntBefore('\n');
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-            sockets[mux]->got_data = true;
-            if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
-          }
-          data = "";
-          // DBG("### Got Data:", len, "on", mux);
-        } else if (data.endsWith(GF("CLOSED" GSM_NL))) {
-          int8_t nl   = data.lastIndexOf(GSM_NL, data.length() - 8);
-          int8_t coma = data.indexOf(',', nl + 2);
-          int8_t mux  = data.substring(nl + 2, coma).toInt();
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-            sockets[mux]->sock_connected = false;
-          }
-          data = "";
-          DBG("### Closed: ", mux);
-        } else if (data.endsWith(GF("*PSNWID:"))) {
-          streamSkipUntil('\n');  // Refresh network name by network
-          data = "";
-          DBG("### Network name updated.");
-        } else if (data.endsWith(GF("*PSUTTZ:"))) {
-          streamSkipUntil('\n');  // Refresh time and time zone by network
-          data = "";
-          DBG("### Network time and time zone updated.");
-        } else if (data.endsWith(GF("+CTZV:"))) {
-          streamSkipUntil('\n');  // Refresh network time zone by network
-          data = "";
-          DBG("### Network time zone updated.");
-        } else if (data.endsWith(GF("DST: "))) {
-          streamSkipUntil(
-              '\n');  // Refresh Network Daylight Saving Time by network
-          data = "";
-          DBG("### Daylight savings time state updated.");
-        }
-      }
-    } while (millis() - startMillis < timeout_ms);
-  finish:
-    if (!index) {
-      data.trim();
-      if (data.length()) { DBG("### Unhandled:", data); }
-      data = "";
-    }
-    // data.replace(GSM_NL, "/");
-    // DBG('<', index, '>', data);
-    return index;
+    return parseResponse(timeout_ms, &data, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(uint32_t timeout_ms, GsmConstStr r1 = GFP(GSM_OK),
@@ -922,8 +970,7 @@ public:
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    String data;
-    return waitResponse(timeout_ms, data, r1, r2, r3, r4, r5);
+    return parseResponse(timeout_ms, NULL, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(GsmConstStr r1 = GFP(GSM_OK),
@@ -938,6 +985,121 @@ public:
     return waitResponse(1000, r1, r2, r3, r4, r5);
   }
 
+ protected:
+  // URCs, matched anywhere in the modem's output
+  static UrcTable urcTable() {
+    static constexpr Urc urcs[] TINY_GSM_PROGMEM = {
+        {GSM_NL "+CIPRXGET:", &TinyGsmSim7000::onCipRxGet},
+        {GSM_NL "+CARECV:", &TinyGsmSim7000::onCaRecv},
+        {GSM_NL "+CADATAIND:", &TinyGsmSim7000::onCaDataInd},
+        {GSM_NL "+CASTATE:", &TinyGsmSim7000::onCaState},
+        {GSM_NL "+RECEIVE:", &TinyGsmSim7000::onReceive},
+        {"CLOSED" GSM_NL, &TinyGsmSim7000::onClosed},
+        {"*PSNWID:", &TinyGsmSim7000::onPsNwId},
+        {"*PSUTTZ:", &TinyGsmSim7000::onPsUtTz},
+        {"+CTZV:", &TinyGsmSim7000::onCtzv},
+        {"DST: ", &TinyGsmSim7000::onDst},
+        {GSM_NL "+CEREG:", &TinyGsmSim7000::onCereg},
+        {GSM_NL "+CGREG:", &TinyGsmSim7000::onCgreg},
+        {GSM_NL "+CGEV:", &TinyGsmSim7000::onBearerEvent},
+        {GSM_NL "+PDP: DEACT", &TinyGsmSim7000::onBearerEvent},
+        {GSM_NL "+CSQ:", &TinyGsmSim7000::onSignalReport},
+        {"", NULL}};
+    typedef TinyGsmTrie<TinyGsmTrieSize(urcs)> Trie;
+    static constexpr Trie trie TINY_GSM_PROGMEM = Trie::of(urcs);
+    return {urcs, trie.nodes};
+  }
+
+  bool onCipRxGet(UrcContext& ctx) {
+    int8_t mode = streamGetIntBefore(',');
+    if (mode != 1) {
+      // The answer to a +CIPRXGET=<mode> command, not a notification
+      if (ctx.data) { *ctx.data += mode; }
+      return false;
+    }
+    int8_t mux = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->got_data = true;
+    }
+    // DBG("### Got Data:", mux);
+    return true;
+  }
+
+  bool onCaRecv(UrcContext&) {
+    int8_t mux = streamGetIntBefore(',');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->got_data = true;
+    }
+    // DBG("### Got Data:", mux);
+    return true;
+  }
+
+  bool onCaDataInd(UrcContext&) {
+    int8_t mux = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->got_data = true;
+    }
+    // DBG("### Got Data:", mux);
+    return true;
+  }
+
+  bool onCaState(UrcContext&) {
+    int8_t mux = streamGetIntBefore(',');
+    int8_t state = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+        if (state != 1)
+        {
+          sockets[mux]->sock_connected = false;
+          DBG("### Closed: ", mux);
+        }
+    }
+    return true;
+  }
+
+  bool onReceive(UrcContext&) {
+    int8_t  mux = streamGetIntBefore(',');
+    int16_t len = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->got_data = true;
+      if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
+    }
+    // DBG("### Got Data:", len, "on", mux);
+    return true;
+  }
+
+  bool onClosed(UrcContext& ctx) {
+    int8_t mux = ctx.seen.lineInt(8);  // "<mux>, CLOSED"
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = false;
+    }
+    DBG("### Closed: ", mux);
+    return true;
+  }
+
+  bool onPsNwId(UrcContext&) {
+    streamSkipUntil('\n');  // Refresh network name by network
+    DBG("### Network name updated.");
+    return true;
+  }
+
+  bool onPsUtTz(UrcContext&) {
+    streamSkipUntil('\n');  // Refresh time and time zone by network
+    DBG("### Network time and time zone updated.");
+    return true;
+  }
+
+  bool onCtzv(UrcContext&) {
+    streamSkipUntil('\n');  // Refresh network time zone by network
+    DBG("### Network time zone updated.");
+    return true;
+  }
+
+  bool onDst(UrcContext&) {
+    streamSkipUntil('\n');  // Refresh Network Daylight Saving Time by network
+    DBG("### Daylight savings time state updated.");
+    return true;
+  }
+
  public:
   Stream& stream;
 
@@ -945,6 +1107,32 @@ public:
   GsmClientSim7000* sockets[TINY_GSM_MUX_COUNT];
   String certificates[TINY_GSM_MUX_COUNT];
   const char*       gsmNL = GSM_NL;
+
+  // What the connects so far left set up in the modem, so that a reconnect
+  // sends only the settings that changed.  Forgotten by init().
+  struct ConnectProfile {
+    ConnectProfile() : ssl(-1), protocol(false) {}
+
+    int8_t ssl;       // -1 when not known
+    bool   protocol;  // set to TCP
+    String cacert;
+    String sni;
+  };
+  ConnectProfile profiles[TINY_GSM_MUX_COUNT];
+  int8_t         profileCid    = -1;     // of the last +CACID
+  bool           profileSslCtx = false;  // SSL context 0 is set to TLS 1.2
+
+  // The connection of the open bulk send session, or -1
+  int8_t   bulkMux    = -1;
+  uint32_t bulkLastTx = 0;  // millis() of the last write in the session
+
+  void forgetProfiles() {
+    for (int mux = 0; mux < TINY_GSM_MUX_COUNT; mux++) {
+      profiles[mux] = ConnectProfile();
+    }
+    profileCid    = -1;
+    profileSslCtx = false;
+  }
 };
 
 #endif  // SRC_TINYGSMCLIENTSIM7000_H_
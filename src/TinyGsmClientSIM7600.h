@@ -95,6 +95,7 @@ class TinyGsmSim7600 : public TinyGsmModem<TinyGsmSim7600>,
 
    public:
     virtual int connect(const char* host, uint16_t port, int timeout_s) {
+      TINY_GSM_LOCK(at->commandLock());
       stop();
       TINY_GSM_YIELD();
       rx.clear();
@@ -104,6 +105,8 @@ class TinyGsmSim7600 : public TinyGsmModem<TinyGsmSim7600>,
     TINY_GSM_CLIENT_CONNECT_OVERRIDES
 
     void stop(uint32_t maxWaitMs) {
+      TINY_GSM_LOCK(at->commandLock());
+      endTx();
       dumpModemBuffer(maxWaitMs);
       at->sendAT(GF("+CIPCLOSE="), mux);
       sock_connected = false;
@@ -136,6 +139,7 @@ class TinyGsmSim7600 : public TinyGsmModem<TinyGsmSim7600>,
 
   public:
     int connect(const char* host, uint16_t port, int timeout_s) override {
+      TINY_GSM_LOCK(at->commandLock());
       stop();
       TINY_GSM_YIELD();
       rx.clear();
@@ -262,6 +266,12 @@ class TinyGsmSim7600 : public TinyGsmModem<TinyGsmSim7600>,
     return (s == REG_OK_HOME || s == REG_OK_ROAMING);
   }
 
+  // Automatic +CSQ reports, on every change of the signal
+  bool signalReportsImpl(bool enable) {
+    sendAT(GF("+AUTOCSQ="), enable ? GF("1,1") : GF("0"));
+    return waitResponse() == 1;
+  }
+
  public:
   String getNetworkModes() {
     sendAT(GF("+CNMP=?"));
@@ -451,82 +461,44 @@ class TinyGsmSim7600 : public TinyGsmModem<TinyGsmSim7600>,
     sendAT(GF("+CGNSSINFO"));
     if (waitResponse(GF(GSM_NL "+CGNSSINFO:")) != 1) { return false; }
 
-    uint8_t fixMode = streamGetIntBefore(',');  // mode 2=2D Fix or 3=3DFix
-                                                // TODO(?) Can 1 be returned
-    if (fixMode == 1 || fixMode == 2 || fixMode == 3) {
-      // init variables
-      float ilat = 0;
-      char  north;
-      float ilon = 0;
-      char  east;
-      float ispeed       = 0;
-      float ialt         = 0;
-      int   ivsat        = 0;
-      int   iusat        = 0;
-      float iaccuracy    = 0;
-      int   iyear        = 0;
-      int   imonth       = 0;
-      int   iday         = 0;
-      int   ihour        = 0;
-      int   imin         = 0;
-      float secondWithSS = 0;
-
-      streamSkipUntil(',');               // GPS satellite valid numbers
-      streamSkipUntil(',');               // GLONASS satellite valid numbers
-      streamSkipUntil(',');               // BEIDOU satellite valid numbers
-      ilat  = streamGetFloatBefore(',');  // Latitude in ddmm.mmmmmm
-      north = stream.read();              // N/S Indicator, N=north or S=south
-      streamSkipUntil(',');
-      ilon = streamGetFloatBefore(',');  // Longitude in ddmm.mmmmmm
-      east = stream.read();              // E/W Indicator, E=east or W=west
-      streamSkipUntil(',');
-
-      // Date. Output format is ddmmyy
-      iday   = streamGetIntLength(2);    // Two digit day
-      imonth = streamGetIntLength(2);    // Two digit month
-      iyear  = streamGetIntBefore(',');  // Two digit year
-
-      // UTC Time. Output format is hhmmss.s
-      ihour = streamGetIntLength(2);  // Two digit hour
-      imin  = streamGetIntLength(2);  // Two digit minute
-      secondWithSS =
-          streamGetFloatBefore(',');  // 4 digit second with subseconds
-
-      ialt   = streamGetFloatBefore(',');  // MSL Altitude. Unit is meters
-      ispeed = streamGetFloatBefore(',');  // Speed Over Ground. Unit is knots.
-      streamSkipUntil(',');                // Course Over Ground. Degrees.
-      streamSkipUntil(',');  // After set, will report GPS every x seconds
-      iaccuracy = streamGetFloatBefore(',');  // Position Dilution Of Precision
-      streamSkipUntil(',');   // Horizontal Dilution Of Precision
-      streamSkipUntil(',');   // Vertical Dilution Of Precision
-      streamSkipUntil('\n');  // TODO(?) is one more field reported??
-
-      // Set pointers
-      if (lat != NULL)
-        *lat = (floor(ilat / 100) + fmod(ilat, 100.) / 60) *
-            (north == 'N' ? 1 : -1);
-      if (lon != NULL)
-        *lon = (floor(ilon / 100) + fmod(ilon, 100.) / 60) *
-            (east == 'E' ? 1 : -1);
-      if (speed != NULL) *speed = ispeed;
-      if (alt != NULL) *alt = ialt;
-      if (vsat != NULL) *vsat = ivsat;
-      if (usat != NULL) *usat = iusat;
-      if (accuracy != NULL) *accuracy = iaccuracy;
-      if (iyear < 2000) iyear += 2000;
-      if (year != NULL) *year = iyear;
-      if (month != NULL) *month = imonth;
-      if (day != NULL) *day = iday;
-      if (hour != NULL) *hour = ihour;
-      if (minute != NULL) *minute = imin;
-      if (second != NULL) *second = static_cast<int>(secondWithSS);
-
-      waitResponse();
-      return true;
-    }
-
+    // Fix mode, GPS, GLONASS and BEIDOU satellites, latitude (ddmm.mmmmmm),
+    // N/S, longitude (dddmm.mmmmmm), E/W, date (ddMMyy), UTC time
+    // (hhmmss.s), MSL altitude (m), speed over ground (knots), course over
+    // ground, PDOP, HDOP, VDOP
+    TinyGsmFields fields;
+    streamGetFields(fields);
     waitResponse();
-    return false;
+
+    int fixMode = fields.toInt(0);  // mode 2=2D Fix or 3=3DFix
+                                    // TODO(?) Can 1 be returned
+    if (fixMode != 1 && fixMode != 2 && fixMode != 3) { return false; }
+
+    float ilat  = fields.toFloat(4);
+    char  north = fields.str(5)[0];
+    float ilon  = fields.toFloat(6);
+    char  east  = fields.str(7)[0];
+    int   iyear = fields.digits(8, 4, 2);  // Two digit year
+    if (iyear < 2000) iyear += 2000;
+
+    // Set pointers
+    if (lat != NULL)
+      *lat = (floor(ilat / 100) + fmod(ilat, 100.) / 60) *
+          (north == 'N' ? 1 : -1);
+    if (lon != NULL)
+      *lon = (floor(ilon / 100) + fmod(ilon, 100.) / 60) *
+          (east == 'E' ? 1 : -1);
+    if (speed != NULL) *speed = fields.toFloat(11);
+    if (alt != NULL) *alt = fields.toFloat(10);
+    if (vsat != NULL) *vsat = 0;
+    if (usat != NULL) *usat = 0;
+    if (accuracy != NULL) *accuracy = fields.toFloat(14);
+    if (year != NULL) *year = iyear;
+    if (month != NULL) *month = fields.digits(8, 2, 2);
+    if (day != NULL) *day = fields.digits(8, 0, 2);
+    if (hour != NULL) *hour = fields.digits(9, 0, 2);
+    if (minute != NULL) *minute = fields.digits(9, 2, 2);
+    if (second != NULL) *second = fields.digits(9, 4, 2);
+    return true;
   }
 
 
@@ -567,13 +539,13 @@ class TinyGsmSim7600 : public TinyGsmModem<TinyGsmSim7600>,
     sendAT(GF("+CBC"));
     if (waitResponse(GF(GSM_NL "+CBC:")) != 1) { return 0; }
 
-    // get voltage in VOLTS
-    float voltage = streamGetFloatBefore('\n');
+    // voltage in VOLTS, e.g. "3.950V"
+    TinyGsmFields fields;
+    streamGetFields(fields);
     // Wait for final OK
     waitResponse();
     // Return millivolts
-    uint16_t res = voltage * 1000;
-    return res;
+    return fields.toFixed(0, 3);
   }
 
   int8_t getBattPercentImpl() TINY_GSM_ATTR_NOT_AVAILABLE;
@@ -654,27 +626,12 @@ class TinyGsmSim7600 : public TinyGsmModem<TinyGsmSim7600>,
     //  ^^ Requested number of data bytes (1-1460 bytes)to be read
     int16_t len_confirmed = streamGetIntBefore('\n');
     // ^^ The data length which not read in the buffer
-    for (int i = 0; i < len_requested; i++) {
-      uint32_t startMillis = millis();
+    if (len_requested > 0) {
 #ifdef TINY_GSM_USE_HEX
-      while (stream.available() < 2 &&
-             (millis() - startMillis < sockets[mux]->_timeout)) {
-        TINY_GSM_YIELD();
-      }
-      char buf[4] = {
-          0,
-      };
-      buf[0] = stream.read();
-      buf[1] = stream.read();
-      char c = strtol(buf, NULL, 16);
+      moveHexFromStreamToFifo(mux, len_requested);
 #else
-      while (!stream.available() &&
-             (millis() - startMillis < sockets[mux]->_timeout)) {
-        TINY_GSM_YIELD();
-      }
-      char c = stream.read();
+      moveCharsFromStreamToFifo(mux, len_requested);
 #endif
-      sockets[mux]->rx.put(c);
     }
     // DBG("### READ:", len_requested, "from", mux);
     // sockets[mux]->sock_available = modemGetAvailable(mux);
@@ -704,9 +661,11 @@ class TinyGsmSim7600 : public TinyGsmModem<TinyGsmSim7600>,
     if (waitResponse(GF("+CIPCLOSE:")) != 1) {
       // return false;  // TODO:  Why does this not read correctly?
     }
+    // +CIPCLOSE:<link0_state>,<link1_state>,...,<link9_state>
+    TinyGsmFields fields;
+    streamGetFields(fields);
     for (int muxNo = 0; muxNo < TINY_GSM_MUX_COUNT; muxNo++) {
-      // +CIPCLOSE:<link0_state>,<link1_state>,...,<link9_state>
-      bool muxState = stream.parseInt();
+      bool muxState = fields.toInt(muxNo, 0);
       if (sockets[muxNo]) { sockets[muxNo]->sock_connected = muxState; }
     }
     waitResponse();  // Should be an OK at the end
@@ -718,7 +677,6 @@ class TinyGsmSim7600 : public TinyGsmModem<TinyGsmSim7600>,
    * Utilities
    */
  public:
-  // TODO(vshymanskyy): Optimize this!
   int8_t waitResponse(uint32_t timeout_ms, String& data,
                       GsmConstStr r1 = GFP(GSM_OK),
                       GsmConstStr r2 = GFP(GSM_ERROR),
@@ -729,89 +687,7 @@ class TinyGsmSim7600 : public TinyGsmModem<TinyGsmSim7600>,
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    /*String r1s(r1); r1s.trim();
-    String r2s(r2); r2s.trim();
-    String r3s(r3); r3s.trim();
-    String r4s(r4); r4s.trim();
-    String r5s(r5); r5s.trim();
-    DBG("### ..:", r1s, ",", r2s, ",", r3s, ",", r4s, ",", r5s);*/
-    data.reserve(64);
-    uint8_t  index       = 0;
-    uint32_t startMillis = millis();
-    do {
-      TINY_GSM_YIELD();
-      while (stream.available() > 0) {
-        TINY_GSM_YIELD();
-        int8_t a = stream.read();
-        if (a <= 0) continue;  // Skip 0x00 bytes, just in case
-        data += static_cast<char>(a);
-        if (r1 && data.endsWith(r1)) {
-          index = 1;
-          goto finish;
-        } else if (r2 && data.endsWith(r2)) {
-          index = 2;
-          goto finish;
-        } else if (r3 && data.endsWith(r3)) {
-#if defined TINY_GSM_DEBUG
-          if (r3 == GFP(GSM_CME_ERROR)) {
-            streamSkipUntil('\n');  // Read out the error
-          }
-#endif
-          index = 3;
-          goto finish;
-        } else if (r4 && data.endsWith(r4)) {
-          index = 4;
-          goto finish;
-        } else if (r5 && data.endsWith(r5)) {
-          index = 5;
-          goto finish;
-        } else if (data.endsWith(GF(GSM_NL "+CIPRXGET:"))) {
-          int8_t mode = streamGetIntBefore(',');
-          if (mode == 1) {
-            int8_t mux = streamGetIntBefore('\n');
-            if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-              sockets[mux]->got_data = true;
-            }
-            data = "";
-            // DBG("### Got Data:", mux);
-          } else {
-            data += mode;
-          }
-        } else if (data.endsWith(GF(GSM_NL "+RECEIVE:"))) {
-          int8_t  mux = streamGetIntBefore(',');
-          int16_t len = streamGetIntBefore('\n');
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-            sockets[mux]->got_data = true;
-            if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
-          }
-          data = "";
-          // DBG("### Got Data:", len, "on", mux);
-        } else if (data.endsWith(GF("+IPCLOSE:"))) {
-          int8_t mux = streamGetIntBefore(',');
-          streamSkipUntil('\n');  // Skip the reason code
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-            sockets[mux]->sock_connected = false;
-          }
-          data = "";
-          DBG("### Closed: ", mux);
-        } else if (data.endsWith(GF("+CIPEVENT:"))) {
-          // Need to close all open sockets and release the network library.
-          // User will then need to reconnect.
-          DBG("### Network error!");
-          if (!isGprsConnected()) { gprsDisconnect(); }
-          data = "";
-        }
-      }
-    } while (millis() - startMillis < timeout_ms);
-  finish:
-    if (!index) {
-      data.trim();
-      if (data.length()) { DBG("### Unhandled:", data); }
-      data = "";
-    }
-    // data.replace(GSM_NL, "/");
-    // DBG('<', index, '>', data);
-    return index;
+    return parseResponse(timeout_ms, &data, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(uint32_t timeout_ms, GsmConstStr r1 = GFP(GSM_OK),
@@ -823,8 +699,7 @@ class TinyGsmSim7600 : public TinyGsmModem<TinyGsmSim7600>,
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    String data;
-    return waitResponse(timeout_ms, data, r1, r2, r3, r4, r5);
+    return parseResponse(timeout_ms, NULL, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(GsmConstStr r1 = GFP(GSM_OK),
@@ -839,6 +714,67 @@ class TinyGsmSim7600 : public TinyGsmModem<TinyGsmSim7600>,
     return waitResponse(1000, r1, r2, r3, r4, r5);
   }
 
+ protected:
+  // URCs, matched anywhere in the modem's output
+  static UrcTable urcTable() {
+    static constexpr Urc urcs[] TINY_GSM_PROGMEM = {
+        {GSM_NL "+CIPRXGET:", &TinyGsmSim7600::onCipRxGet},
+        {GSM_NL "+RECEIVE:", &TinyGsmSim7600::onReceive},
+        {"+IPCLOSE:", &TinyGsmSim7600::onIpClose},
+        {"+CIPEVENT:", &TinyGsmSim7600::onCipEvent},
+        {GSM_NL "+CGREG:", &TinyGsmSim7600::onCgreg},
+        {GSM_NL "+CGEV:", &TinyGsmSim7600::onBearerEvent},
+        {GSM_NL "+PDP: DEACT", &TinyGsmSim7600::onBearerEvent},
+        {GSM_NL "+CSQ:", &TinyGsmSim7600::onSignalReport},
+        {"", NULL}};
+    typedef TinyGsmTrie<TinyGsmTrieSize(urcs)> Trie;
+    static constexpr Trie trie TINY_GSM_PROGMEM = Trie::of(urcs);
+    return {urcs, trie.nodes};
+  }
+
+  bool onCipRxGet(UrcContext& ctx) {
+    int8_t mode = streamGetIntBefore(',');
+    if (mode != 1) {
+      // The answer to a +CIPRXGET=<mode> command, not a notification
+      if (ctx.data) { *ctx.data += mode; }
+      return false;
+    }
+    int8_t mux = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->got_data = true;
+    }
+    // DBG("### Got Data:", mux);
+    return true;
+  }
+
+  bool onReceive(UrcContext&) {
+    int8_t  mux = streamGetIntBefore(',');
+    int16_t len = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->got_data = true;
+      if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
+    }
+    // DBG("### Got Data:", len, "on", mux);
+    return true;
+  }
+
+  bool onIpClose(UrcContext&) {
+    int8_t mux = streamGetIntBefore(',');
+    streamSkipUntil('\n');  // Skip the reason code
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = false;
+    }
+    DBG("### Closed: ", mux);
+    return true;
+  }
+
+  bool onCipEvent(UrcContext&) {
+    // User will then need to reconnect.
+    DBG("### Network error!");
+    if (!isGprsConnected()) { gprsDisconnect(); }
+    return true;
+  }
+
  public:
   Stream& stream;
 
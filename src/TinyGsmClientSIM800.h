@@ -16,6 +16,17 @@
 #define TINY_GSM_MUX_COUNT 5
 #define TINY_GSM_BUFFER_READ_AND_CHECK_SIZE
 
+// Bytes a connection may have sent that the server has not acknowledged yet
+// (AT+CIPACK) before write() waits for the acknowledgements
+#if !defined(TINY_GSM_SEND_WINDOW)
+#define TINY_GSM_SEND_WINDOW 5840
+#endif
+
+// Time between AT+CIPACK polls while the send window is full
+#if !defined(TINY_GSM_ACK_POLL_MS)
+#define TINY_GSM_ACK_POLL_MS 50
+#endif
+
 #include "TinyGsmBattery.tpp"
 #include "TinyGsmCalling.tpp"
 #include "TinyGsmGPRS.tpp"
@@ -82,6 +93,9 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
       prev_check     = 0;
       sock_connected = false;
       got_data       = false;
+      tx_unacked     = 0;
+      tx_pending     = 0;
+      tx_failed      = false;
 
       if (mux < TINY_GSM_MUX_COUNT) {
         this->mux = mux;
@@ -95,6 +109,7 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
 
    public:
     virtual int connect(const char* host, uint16_t port, int timeout_s) {
+      TINY_GSM_LOCK(at->commandLock());
       stop();
       TINY_GSM_YIELD();
       rx.clear();
@@ -103,11 +118,141 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
     }
     TINY_GSM_CLIENT_CONNECT_OVERRIDES
 
+    // Also waits for the modem to take everything written; when it does not,
+    // the connection is failed and the next write() returns 0
+    void flush() override {
+      TINY_GSM_LOCK(at->commandLock());
+      GsmClient::flush();
+      at->modemWaitAccepted(mux);
+    }
+
     void stop(uint32_t maxWaitMs) {
+      TINY_GSM_LOCK(at->commandLock());
+      endTx();
       dumpModemBuffer(maxWaitMs);
       at->sendAT(GF("+CIPCLOSE="), mux, GF(",1"));  // Quick close
       sock_connected = false;
       at->waitResponse();
+      // What was in flight went with the connection
+      tx_unacked = 0;
+      tx_pending = 0;
+      tx_failed  = false;
+    }
+    void stop() override {
+      stop(15000L);
+    }
+
+    /*
+     * Extended API
+     */
+
+    String remoteIP() TINY_GSM_ATTR_NOT_IMPLEMENTED;
+
+   protected:
+    uint16_t tx_unacked;  // sent and not known to be acknowledged
+    uint8_t  tx_pending;  // sends the modem has not accepted yet
+    bool     tx_failed;   // a send failed, nothing more goes out
+  };
+
+  /*
+   * Inner Transparent Client
+   */
+ public:
+  // The one connection of a modem set up with setTransparentMode(): in the
+  // modem's transparent mode (AT+CIPMODE=1) the bytes go both ways as they
+  // are, with no AT framing.  A modem command made while it is open takes
+  // the modem out of data mode with +++, and the next use of the client goes
+  // back in with ATO.  A close by the server cannot be told apart from data
+  // until then.  maintain() asks nothing while the modem is in data mode.
+  // What arrives while the client is out of room is lost (see getRxLost()).
+  class GsmClientTransparentSim800 : public GsmClient {
+    friend class TinyGsmSim800;
+
+   public:
+    GsmClientTransparentSim800() {}
+
+    explicit GsmClientTransparentSim800(TinyGsmSim800& modem) {
+      init(&modem);
+    }
+
+    bool init(TinyGsmSim800* modem) {
+      this->at       = modem;
+      this->mux      = 0;
+      sock_available = 0;
+      prev_check     = 0;
+      sock_connected = false;
+      got_data       = false;
+      return true;
+    }
+
+   public:
+    virtual int connect(const char* host, uint16_t port, int timeout_s) {
+      TINY_GSM_LOCK(at->commandLock());
+      stop();
+      TINY_GSM_YIELD();
+      rx.clear();
+      sock_connected = at->modemConnectTransparent(this, host, port,
+                                                   timeout_s);
+      return sock_connected;
+    }
+    TINY_GSM_CLIENT_CONNECT_OVERRIDES
+
+    size_t write(const uint8_t* buf, size_t size) override {
+      TINY_GSM_LOCK(at->commandLock());
+      if (!at->modemResume(this)) { return 0; }
+      return at->modemWriteTransparent(buf, size);
+    }
+
+    size_t write(uint8_t c) override {
+      return write(&c, 1);
+    }
+
+    int available() override {
+      TINY_GSM_LOCK(at->commandLock());
+      if (rx.size()) { return rx.size(); }
+      if (!at->modemResume(this)) { return 0; }
+      return at->stream.available();
+    }
+
+    int read(uint8_t* buf, size_t size) override {
+      TINY_GSM_LOCK(at->commandLock());
+      size_t cnt = rx.size() ? rx.get(buf, TinyGsmMin(size, rx.size())) : 0;
+      if (cnt < size && at->modemResume(this)) {
+        size_t ready = at->stream.available();
+        cnt += at->stream.readBytes(reinterpret_cast<char*>(buf) + cnt,
+                                    TinyGsmMin(size - cnt, ready));
+      }
+      return cnt;
+    }
+
+    int read() override {
+      uint8_t c;
+      if (read(&c, 1) == 1) { return c; }
+      return -1;
+    }
+
+    int peek() override {
+      TINY_GSM_LOCK(at->commandLock());
+      if (rx.size() || !at->modemResume(this)) { return -1; }
+      return at->stream.peek();
+    }
+
+    void flush() override {
+      at->stream.flush();
+    }
+
+    uint8_t connected() override {
+      TINY_GSM_LOCK(at->commandLock());
+      if (rx.size()) { return true; }
+      return sock_connected &&
+             at->transparentState != TinyGsmSim800::TRANSPARENT_CLOSED;
+    }
+
+    void stop(uint32_t) {
+      TINY_GSM_LOCK(at->commandLock());
+      if (sock_connected) { at->modemCloseTransparent(); }
+      sock_connected = false;
+      rx.clear();
     }
     void stop() override {
       stop(15000L);
@@ -133,6 +278,7 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
 
    public:
     int connect(const char* host, uint16_t port, int timeout_s) override {
+      TINY_GSM_LOCK(at->commandLock());
       stop();
       TINY_GSM_YIELD();
       rx.clear();
@@ -146,7 +292,12 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
    * Constructor
    */
  public:
-  explicit TinyGsmSim800(Stream& stream) : stream(stream) {
+  explicit TinyGsmSim800(Stream& stream)
+      : stream(stream),
+        transparentMode(false),
+        transparentState(TRANSPARENT_CLOSED),
+        transparentClient(NULL),
+        transparentLastTx(0) {
     memset(sockets, 0, sizeof(sockets));
   }
 
@@ -297,6 +448,12 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
     return (s == REG_OK_HOME || s == REG_OK_ROAMING);
   }
 
+  // +CSQN reports, on every change of the signal
+  bool signalReportsImpl(bool enable) {
+    sendAT(GF("+EXUNSOL=\"SQ\","), enable);
+    return waitResponse() == 1;
+  }
+
   String getLocalIPImpl() {
     sendAT(GF("+CIFSR;E0"));
     String res;
@@ -353,17 +510,26 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
 
     // TODO(?): wait AT+CGATT?
 
-    // Set to multi-IP
-    sendAT(GF("+CIPMUX=1"));
-    if (waitResponse() != 1) { return false; }
+    if (transparentMode) {
+      // One connection, in transparent mode
+      sendAT(GF("+CIPMUX=0"));
+      if (waitResponse() != 1) { return false; }
 
-    // Put in "quick send" mode (thus no extra "Send OK")
-    sendAT(GF("+CIPQSEND=1"));
-    if (waitResponse() != 1) { return false; }
+      sendAT(GF("+CIPMODE=1"));
+      if (waitResponse() != 1) { return false; }
+    } else {
+      // Set to multi-IP
+      sendAT(GF("+CIPMUX=1"));
+      if (waitResponse() != 1) { return false; }
 
-    // Set to get data manually
-    sendAT(GF("+CIPRXGET=1"));
-    if (waitResponse() != 1) { return false; }
+      // Put in "quick send" mode (thus no extra "Send OK")
+      sendAT(GF("+CIPQSEND=1"));
+      if (waitResponse() != 1) { return false; }
+
+      // Set to get data manually
+      sendAT(GF("+CIPRXGET=1"));
+      if (waitResponse() != 1) { return false; }
+    }
 
     // Start Task and Set APN, USER NAME, PASSWORD
     sendAT(GF("+CSTT=\""), apn, GF("\",\""), user, GF("\",\""), pwd, GF("\""));
@@ -505,6 +671,90 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
    * Client related functions
    */
  protected:
+  /*
+   * Transparent mode
+   */
+ public:
+  // The next gprsConnect() sets the modem up for a single connection in
+  // transparent mode, for GsmClientTransparentSim800 (the other clients do
+  // not work then), or back for several connections
+  void setTransparentMode(bool on) {
+    transparentMode = on;
+  }
+
+ protected:
+  enum TransparentState {
+    TRANSPARENT_CLOSED,
+    TRANSPARENT_DATA,     // the connection has the UART
+    TRANSPARENT_COMMAND,  // left for a command; ATO goes back
+  };
+
+  bool inDataModeImpl() {
+    return transparentState == TRANSPARENT_DATA;
+  }
+  void leaveDataModeImpl() {
+    modemEscape();
+  }
+
+  bool modemConnectTransparent(GsmClientTransparentSim800* client,
+                               const char* host, uint16_t port,
+                               int timeout_s) {
+    uint32_t timeout_ms = ((uint32_t)timeout_s) * 1000;
+    transparentClient   = client;
+    sendAT(GF("+CIPSTART=\"TCP\",\""), host, GF("\","), port);
+    if (waitResponse() != 1) { return false; }
+    if (waitResponse(timeout_ms, GF(GSM_NL "CONNECT" GSM_NL),
+                     GF("CONNECT FAIL" GSM_NL), GF("ALREADY CONNECT" GSM_NL),
+                     GF("ERROR" GSM_NL)) != 1) {
+      return false;
+    }
+    transparentState  = TRANSPARENT_DATA;
+    transparentLastTx = millis();
+    return true;
+  }
+
+  size_t modemWriteTransparent(const uint8_t* buf, size_t size) {
+    size_t done       = stream.write(buf, size);
+    transparentLastTx = millis();
+    return done;
+  }
+
+  // +++, with a guard time of silence on either side of it.  What arrives
+  // before it still goes to the client.  If the modem does not take it, it
+  // stays in data mode for the next command to try again.
+  bool modemEscape() {
+    transparentState = TRANSPARENT_COMMAND;  // for the answer to be read
+    if (escapeDataMode(transparentClient, transparentLastTx)) { return true; }
+    transparentState  = TRANSPARENT_DATA;
+    transparentLastTx = millis();
+    return false;
+  }
+
+  // Back to data mode if a command took the modem out of it; false once the
+  // connection is gone
+  bool modemResume(GsmClientTransparentSim800* client) {
+    if (transparentClient != client) { return false; }
+    if (transparentState == TRANSPARENT_COMMAND) {
+      sendAT(GF("O"));
+      if (waitResponse(GF("CONNECT" GSM_NL), GF("NO CARRIER"),
+                       GFP(GSM_ERROR)) == 1) {
+        transparentState  = TRANSPARENT_DATA;
+        transparentLastTx = millis();
+      } else {
+        transparentState = TRANSPARENT_CLOSED;
+      }
+    }
+    return transparentState == TRANSPARENT_DATA;
+  }
+
+  void modemCloseTransparent() {
+    if (transparentState == TRANSPARENT_CLOSED) { return; }
+    if (transparentState == TRANSPARENT_DATA && !modemEscape()) { return; }
+    transparentState = TRANSPARENT_CLOSED;
+    sendAT(GF("+CIPCLOSE=1"));  // Quick close
+    waitResponse(GF("CLOSE OK"), GFP(GSM_ERROR));
+  }
+
   bool modemConnect(const char* host, uint16_t port, uint8_t mux,
                     bool ssl = false, int timeout_s = 75) {
     int8_t   rsp;
@@ -535,14 +785,72 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
     return (1 == rsp);
   }
 
+  // In quick send mode the modem answers a send with DATA ACCEPT once the
+  // data is in its buffer, so the next send goes out without waiting for it:
+  // the answer is taken as a URC.  Only when TINY_GSM_SEND_WINDOW bytes are
+  // out unacknowledged does a send wait, asking AT+CIPACK how many still are.
+  // A send the modem refuses (SEND FAIL, or ERROR) fails the connection: it
+  // shows on the next write, which returns 0, as does every one after it.
   int16_t modemSend(const void* buff, size_t len, uint8_t mux) {
+    GsmClientSim800* sock = sockets[mux];
+    if (!sock || sock->tx_failed) { return 0; }
+    if (!modemWaitWindow(mux, len)) {
+      sock->tx_failed = true;
+      return 0;
+    }
     sendAT(GF("+CIPSEND="), mux, ',', (uint16_t)len);
-    if (waitResponse(GF(">")) != 1) { return 0; }
+    if (waitResponse(GF(">")) != 1) {
+      sock->tx_failed = true;
+      return 0;
+    }
     stream.write(reinterpret_cast<const uint8_t*>(buff), len);
     stream.flush();
-    if (waitResponse(GF(GSM_NL "DATA ACCEPT:")) != 1) { return 0; }
-    streamSkipUntil(',');  // Skip mux
-    return streamGetIntBefore('\n');
+    sock->tx_unacked += len;
+    sock->tx_pending++;
+    // An earlier send failed while this one waited for the prompt
+    return sock->tx_failed ? 0 : len;
+  }
+
+  // Waits until len more bytes fit in the send window of the connection
+  bool modemWaitWindow(uint8_t mux, size_t len) {
+    GsmClientSim800* sock        = sockets[mux];
+    uint32_t         startMillis = millis();
+    while (sock->tx_unacked && !sock->tx_failed &&
+           sock->tx_unacked + len > TINY_GSM_SEND_WINDOW) {
+      if (millis() - startMillis > 10000L) { return false; }
+      sendAT(GF("+CIPACK="), mux);
+      if (waitResponse(GF("+CIPACK:")) != 1) { return false; }
+      // +CIPACK: <sent>,<acknowledged>,<not acknowledged>
+      streamSkipUntil(',');  // Skip bytes sent
+      streamSkipUntil(',');  // Skip bytes acknowledged
+      sock->tx_unacked = streamGetIntBefore('\n');
+      waitResponse();
+      if (sock->tx_unacked + len > TINY_GSM_SEND_WINDOW) {
+        // Taking URCs meanwhile; an ERROR is the answer to a send
+        if (waitResponse(TINY_GSM_ACK_POLL_MS, GFP(GSM_ERROR), NULL) == 1) {
+          sock->tx_failed = true;
+        }
+      }
+    }
+    return !sock->tx_failed;
+  }
+
+  // Waits for DATA ACCEPT of every send on the connection
+  bool modemWaitAccepted(uint8_t mux) {
+    GsmClientSim800* sock        = sockets[mux];
+    uint32_t         startMillis = millis();
+    if (!sock) { return false; }
+    while (sock->tx_pending && sock->sock_connected && !sock->tx_failed) {
+      if (millis() - startMillis > 10000L) {
+        sock->tx_failed = true;
+        break;
+      }
+      // An ERROR is the answer to a send
+      if (waitResponse(15, GFP(GSM_ERROR), NULL) == 1) {
+        sock->tx_failed = true;
+      }
+    }
+    return !sock->tx_failed;
   }
 
   size_t modemRead(size_t size, uint8_t mux) {
@@ -564,27 +872,12 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
     // SRGD NOTE:  Contrary to above (which is copied from AT command manual)
     // this is actually be the number of bytes that will be remaining in the
     // buffer after the read.
-    for (int i = 0; i < len_requested; i++) {
-      uint32_t startMillis = millis();
+    if (len_requested > 0) {
 #ifdef TINY_GSM_USE_HEX
-      while (stream.available() < 2 &&
-             (millis() - startMillis < sockets[mux]->_timeout)) {
-        TINY_GSM_YIELD();
-      }
-      char buf[4] = {
-          0,
-      };
-      buf[0] = stream.read();
-      buf[1] = stream.read();
-      char c = strtol(buf, NULL, 16);
+      moveHexFromStreamToFifo(mux, len_requested);
 #else
-      while (!stream.available() &&
-             (millis() - startMillis < sockets[mux]->_timeout)) {
-        TINY_GSM_YIELD();
-      }
-      char c = stream.read();
+      moveCharsFromStreamToFifo(mux, len_requested);
 #endif
-      sockets[mux]->rx.put(c);
     }
     // DBG("### READ:", len_requested, "from", mux);
     // sockets[mux]->sock_available = modemGetAvailable(mux);
@@ -593,7 +886,7 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
     return len_requested;
   }
 
-  size_t modemGetAvailable(uint8_t mux) {
+  size_t modemGetAvailable(uint8_t mux, bool checkState = true) {
     if (!sockets[mux]) return 0;
     sendAT(GF("+CIPRXGET=4,"), mux);
     size_t result = 0;
@@ -604,10 +897,26 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
       waitResponse();
     }
     // DBG("### Available:", result, "on", mux);
-    if (!result) { sockets[mux]->sock_connected = modemGetConnected(mux); }
+    if (!result && checkState) {
+      sockets[mux]->sock_connected = modemGetConnected(mux);
+    }
     return result;
   }
 
+  // +CIPRXGET=4 is asked per socket, but a bare +CIPSTATUS lists every
+  // connection, so the sockets found empty have their state checked together
+  void modemGetAvailableAll() {
+    bool check = false;
+    for (int mux = 0; mux < TINY_GSM_MUX_COUNT; mux++) {
+      GsmClientSim800* sock = sockets[mux];
+      if (!sock || !sock->got_data) continue;
+      sock->got_data       = false;
+      sock->sock_available = modemGetAvailable(mux, false);
+      if (!sock->sock_available) { check = true; }
+    }
+    if (check) { modemGetConnectedAll(); }
+  }
+
   bool modemGetConnected(uint8_t mux) {
     sendAT(GF("+CIPSTATUS="), mux);
     waitResponse(GF("+CIPSTATUS"));
@@ -618,11 +927,26 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
     return 1 == res;
   }
 
+  void modemGetConnectedAll() {
+    sendAT(GF("+CIPSTATUS"));
+    if (waitResponse() != 1) return;
+    // STATE: <state>, then for each of the connections 0 to 5:
+    // C: <n>,<bearer>,<TCP/UDP>,<IP address>,<port>,<client state>
+    TinyGsmFields fields;
+    int           mux = -1;
+    while (mux < 5 && waitResponse(GF(GSM_NL "C: ")) == 1) {
+      streamGetFields(fields);
+      mux = fields.toInt(0, 5);
+      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+        sockets[mux]->sock_connected = strcmp(fields.str(5), "CONNECTED") == 0;
+      }
+    }
+  }
+
   /*
    * Utilities
    */
  public:
-  // TODO(vshymanskyy): Optimize this!
   int8_t waitResponse(uint32_t timeout_ms, String& data,
                       GsmConstStr r1 = GFP(GSM_OK),
                       GsmConstStr r2 = GFP(GSM_ERROR),
@@ -633,101 +957,7 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    /*String r1s(r1); r1s.trim();
-    String r2s(r2); r2s.trim();
-    String r3s(r3); r3s.trim();
-    String r4s(r4); r4s.trim();
-    String r5s(r5); r5s.trim();
-    DBG("### ..:", r1s, ",", r2s, ",", r3s, ",", r4s, ",", r5s);*/
-    data.reserve(64);
-    uint8_t  index       = 0;
-    uint32_t startMillis = millis();
-    do {
-      TINY_GSM_YIELD();
-      while (stream.available() > 0) {
-        TINY_GSM_YIELD();
-        int8_t a = stream.read();
-        if (a <= 0) continue;  // Skip 0x00 bytes, just in case
-        data += static_cast<char>(a);
-        if (r1 && data.endsWith(r1)) {
-          index = 1;
-          goto finish;
-        } else if (r2 && data.endsWith(r2)) {
-          index = 2;
-          goto finish;
-        } else if (r3 && data.endsWith(r3)) {
-#if defined TINY_GSM_DEBUG
-          if (r3 == GFP(GSM_CME_ERROR)) {
-            streamSkipUntil('\n');  // Read out the error
-          }
-#endif
-          index = 3;
-          goto finish;
-        } else if (r4 && data.endsWith(r4)) {
-          index = 4;
-          goto finish;
-        } else if (r5 && data.endsWith(r5)) {
-          index = 5;
-          goto finish;
-        } else if (data.endsWith(GF(GSM_NL "+CIPRXGET:"))) {
-          int8_t mode = streamGetIntBefore(',');
-          if (mode == 1) {
-            int8_t mux = streamGetIntBefore('\n');
-            if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-              sockets[mux]->got_data = true;
-            }
-            data = "";
-            // DBG("### Got Data:", mux);
-          } else {
-            data += mode;
-          }
-        } else if (data.endsWith(GF(GSM_NL "+RECEIVE:"))) {
-          int8_t  mux = streamGetIntBefore(',');
-          int16_t len = streamGetIntBefore('\n');
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-            sockets[mux]->got_data = true;
-            if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
-          }
-          data = "";
-          // DBG("### Got Data:", len, "on", mux);
-        } else if (data.endsWith(GF("CLOSED" GSM_NL))) {
-          int8_t nl   = data.lastIndexOf(GSM_NL, data.length() - 8);
-          int8_t coma = data.indexOf(',', nl + 2);
-          int8_t mux  = data.substring(nl + 2, coma).toInt();
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-            sockets[mux]->sock_connected = false;
-          }
-          data = "";
-          DBG("### Closed: ", mux);
-        } else if (data.endsWith(GF("*PSNWID:"))) {
-          streamSkipUntil('\n');  // Refresh network name by network
-          data = "";
-          DBG("### Network name updated.");
-        } else if (data.endsWith(GF("*PSUTTZ:"))) {
-          streamSkipUntil('\n');  // Refresh time and time zone by network
-          data = "";
-          DBG("### Network time and time zone updated.");
-        } else if (data.endsWith(GF("+CTZV:"))) {
-          streamSkipUntil('\n');  // Refresh network time zone by network
-          data = "";
-          DBG("### Network time zone updated.");
-        } else if (data.endsWith(GF("DST:"))) {
-          streamSkipUntil(
-              '\n');  // Refresh Network Daylight Saving Time by network
-          data = "";
-          DBG("### Daylight savings time state updated.");
-        }
-      }
-    } while (millis() - startMillis < timeout_ms);
-  finish:
-    if (!index) {
-      data.trim();
-      if (data.length()) { DBG("### Unhandled:", data); }
-      data = "";
-    }
-    // data.replace(GSM_NL, "/");
-    // DBG('<', index, '>', data);
-    return index;
+    return parseResponse(timeout_ms, &data, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(uint32_t timeout_ms, GsmConstStr r1 = GFP(GSM_OK),
@@ -739,8 +969,7 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    String data;
-    return waitResponse(timeout_ms, data, r1, r2, r3, r4, r5);
+    return parseResponse(timeout_ms, NULL, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(GsmConstStr r1 = GFP(GSM_OK),
@@ -755,12 +984,121 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
     return waitResponse(1000, r1, r2, r3, r4, r5);
   }
 
+ protected:
+  // URCs, matched anywhere in the modem's output
+  static UrcTable urcTable() {
+    static constexpr Urc urcs[] TINY_GSM_PROGMEM = {
+        {GSM_NL "+CIPRXGET:", &TinyGsmSim800::onCipRxGet},
+        {GSM_NL "+RECEIVE:", &TinyGsmSim800::onReceive},
+        {GSM_NL "DATA ACCEPT:", &TinyGsmSim800::onDataAccept},
+        {"SEND FAIL" GSM_NL, &TinyGsmSim800::onSendFail},
+        {"CLOSED" GSM_NL, &TinyGsmSim800::onClosed},
+        {"*PSNWID:", &TinyGsmSim800::onPsNwId},
+        {"*PSUTTZ:", &TinyGsmSim800::onPsUtTz},
+        {"+CTZV:", &TinyGsmSim800::onCtzv},
+        {"DST:", &TinyGsmSim800::onDst},
+        {GSM_NL "+CREG:", &TinyGsmSim800::onCreg},
+        {GSM_NL "+CGEV:", &TinyGsmSim800::onBearerEvent},
+        {GSM_NL "+PDP: DEACT", &TinyGsmSim800::onBearerEvent},
+        {GSM_NL "+CSQN:", &TinyGsmSim800::onSignalReport},
+        {"", NULL}};
+    typedef TinyGsmTrie<TinyGsmTrieSize(urcs)> Trie;
+    static constexpr Trie trie TINY_GSM_PROGMEM = Trie::of(urcs);
+    return {urcs, trie.nodes};
+  }
+
+  bool onCipRxGet(UrcContext& ctx) {
+    int8_t mode = streamGetIntBefore(',');
+    if (mode != 1) {
+      // The answer to a +CIPRXGET=<mode> command, not a notification
+      if (ctx.data) { *ctx.data += mode; }
+      return false;
+    }
+    int8_t mux = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->got_data = true;
+    }
+    // DBG("### Got Data:", mux);
+    return true;
+  }
+
+  bool onReceive(UrcContext&) {
+    int8_t  mux = streamGetIntBefore(',');
+    int16_t len = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->got_data = true;
+      if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
+    }
+    // DBG("### Got Data:", len, "on", mux);
+    return true;
+  }
+
+  bool onDataAccept(UrcContext&) {
+    int8_t mux = streamGetIntBefore(',');
+    streamSkipUntil('\n');  // Skip the length taken
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux] &&
+        sockets[mux]->tx_pending) {
+      sockets[mux]->tx_pending--;
+    }
+    return true;
+  }
+
+  bool onSendFail(UrcContext& ctx) {
+    int8_t mux = ctx.seen.lineInt(11);  // "<mux>, SEND FAIL"
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      if (sockets[mux]->tx_pending) { sockets[mux]->tx_pending--; }
+      sockets[mux]->tx_failed = true;
+    }
+    DBG("### Send failed: ", mux);
+    return true;
+  }
+
+  bool onClosed(UrcContext& ctx) {
+    int8_t mux = ctx.seen.lineInt(8);  // "<mux>, CLOSED"
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = false;
+    } else if (mux < 0) {
+      // The one connection of transparent mode
+      transparentState = TRANSPARENT_CLOSED;
+    }
+    DBG("### Closed: ", mux);
+    return true;
+  }
+
+  bool onPsNwId(UrcContext&) {
+    streamSkipUntil('\n');  // Refresh network name by network
+    DBG("### Network name updated.");
+    return true;
+  }
+
+  bool onPsUtTz(UrcContext&) {
+    streamSkipUntil('\n');  // Refresh time and time zone by network
+    DBG("### Network time and time zone updated.");
+    return true;
+  }
+
+  bool onCtzv(UrcContext&) {
+    streamSkipUntil('\n');  // Refresh network time zone by network
+    DBG("### Network time zone updated.");
+    return true;
+  }
+
+  bool onDst(UrcContext&) {
+    streamSkipUntil('\n');  // Refresh Network Daylight Saving Time by network
+    DBG("### Daylight savings time state updated.");
+    return true;
+  }
+
  public:
   Stream& stream;
 
  protected:
-  GsmClientSim800* sockets[TINY_GSM_MUX_COUNT];
-  const char*      gsmNL = GSM_NL;
+  GsmClientSim800*            sockets[TINY_GSM_MUX_COUNT];
+  const char*                 gsmNL = GSM_NL;
+  bool                        transparentMode;
+  TransparentState            transparentState;
+  GsmClientTransparentSim800* transparentClient;
+  uint32_t                    transparentLastTx;  // millis() of the last write
 };
 
 #endif  // SRC_TINYGSMCLIENTSIM800_H_
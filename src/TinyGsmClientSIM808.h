@@ -59,75 +59,34 @@ class TinyGsmSim808 : public TinyGsmSim800, public TinyGsmGPS<TinyGsmSim808>, pu
     sendAT(GF("+CGNSINF"));
     if (waitResponse(10000L, GF(GSM_NL "+CGNSINF:")) != 1) { return false; }
 
-    streamSkipUntil(',');                // GNSS run status
-    if (streamGetIntBefore(',') == 1) {  // fix status
-      // init variables
-      float ilat         = 0;
-      float ilon         = 0;
-      float ispeed       = 0;
-      float ialt         = 0;
-      int   ivsat        = 0;
-      int   iusat        = 0;
-      float iaccuracy    = 0;
-      int   iyear        = 0;
-      int   imonth       = 0;
-      int   iday         = 0;
-      int   ihour        = 0;
-      int   imin         = 0;
-      float secondWithSS = 0;
-
-      // UTC date & Time
-      iyear  = streamGetIntLength(4);  // Four digit year
-      imonth = streamGetIntLength(2);  // Two digit month
-      iday   = streamGetIntLength(2);  // Two digit day
-      ihour  = streamGetIntLength(2);  // Two digit hour
-      imin   = streamGetIntLength(2);  // Two digit minute
-      secondWithSS =
-          streamGetFloatBefore(',');  // 6 digit second with subseconds
-
-      ilat   = streamGetFloatBefore(',');  // Latitude
-      ilon   = streamGetFloatBefore(',');  // Longitude
-      ialt   = streamGetFloatBefore(',');  // MSL Altitude. Unit is meters
-      ispeed = streamGetFloatBefore(',');  // Speed Over Ground. Unit is knots.
-      streamSkipUntil(',');                // Course Over Ground. Degrees.
-      streamSkipUntil(',');                // Fix Mode
-      streamSkipUntil(',');                // Reserved1
-      iaccuracy =
-          streamGetFloatBefore(',');    // Horizontal Dilution Of Precision
-      streamSkipUntil(',');             // Position Dilution Of Precision
-      streamSkipUntil(',');             // Vertical Dilution Of Precision
-      streamSkipUntil(',');             // Reserved2
-      ivsat = streamGetIntBefore(',');  // GNSS Satellites in View
-      iusat = streamGetIntBefore(',');  // GNSS Satellites Used
-      streamSkipUntil(',');             // GLONASS Satellites Used
-      streamSkipUntil(',');             // Reserved3
-      streamSkipUntil(',');             // C/N0 max
-      streamSkipUntil(',');             // HPA
-      streamSkipUntil('\n');            // VPA
-
-      // Set pointers
-      if (lat != NULL) *lat = ilat;
-      if (lon != NULL) *lon = ilon;
-      if (speed != NULL) *speed = ispeed;
-      if (alt != NULL) *alt = ialt;
-      if (vsat != NULL) *vsat = ivsat;
-      if (usat != NULL) *usat = iusat;
-      if (accuracy != NULL) *accuracy = iaccuracy;
-      if (iyear < 2000) iyear += 2000;
-      if (year != NULL) *year = iyear;
-      if (month != NULL) *month = imonth;
-      if (day != NULL) *day = iday;
-      if (hour != NULL) *hour = ihour;
-      if (minute != NULL) *minute = imin;
-      if (second != NULL) *second = static_cast<int>(secondWithSS);
-
-      waitResponse();
-      return true;
-    }
-
-    streamSkipUntil('\n');  // toss the row of commas
+    // Run status, fix status, UTC date & time, latitude, longitude, MSL
+    // altitude (m), speed over ground (knots), course over ground, fix mode,
+    // reserved, HDOP, PDOP, VDOP, reserved, GNSS satellites in view, GNSS
+    // satellites used, GLONASS satellites used, reserved, C/N0 max, HPA, VPA
+    TinyGsmFields fields;
+    streamGetFields(fields);
     waitResponse();
-    return false;
+    if (fields.toInt(1) != 1) { return false; }  // no fix, a row of commas
+
+    // UTC date & time as yyyyMMddhhmmss.sss
+    int iyear = fields.digits(2, 0, 4);
+    if (iyear < 2000) iyear += 2000;
+
+    // Set pointers
+    if (lat != NULL) *lat = fields.toFloat(3);
+    if (lon != NULL) *lon = fields.toFloat(4);
+    if (speed != NULL) *speed = fields.toFloat(6);
+    if (alt != NULL) *alt = fields.toFloat(5);
+    if (vsat != NULL) *vsat = fields.toInt(14);
+    if (usat != NULL) *usat = fields.toInt(15);
+    if (accuracy != NULL) *accuracy = fields.toFloat(10);  // HDOP
+    if (year != NULL) *year = iyear;
+    if (month != NULL) *month = fields.digits(2, 4, 2);
+    if (day != NULL) *day = fields.digits(2, 6, 2);
+    if (hour != NULL) *hour = fields.digits(2, 8, 2);
+    if (minute != NULL) *minute = fields.digits(2, 10, 2);
+    if (second != NULL) *second = fields.digits(2, 12, 2);
+    return true;
   }
   
     /*
@@ -98,6 +98,7 @@ class TinyGsmSaraR4 : public TinyGsmModem<TinyGsmSaraR4>,
 
    public:
     virtual int connect(const char* host, uint16_t port, int timeout_s) {
+      TINY_GSM_LOCK(at->commandLock());
       // stop();  // DON'T stop!
       TINY_GSM_YIELD();
       rx.clear();
@@ -124,6 +125,8 @@ class TinyGsmSaraR4 : public TinyGsmModem<TinyGsmSaraR4>,
     }
 
     void stop(uint32_t maxWaitMs) {
+      TINY_GSM_LOCK(at->commandLock());
+      endTx();
       uint32_t startMillis = millis();
       dumpModemBuffer(maxWaitMs);
       // We want to use an async socket close because the syncrhonous close of
@@ -178,6 +181,7 @@ class TinyGsmSaraR4 : public TinyGsmModem<TinyGsmSaraR4>,
 
    public:
     int connect(const char* host, uint16_t port, int timeout_s) override {
+      TINY_GSM_LOCK(at->commandLock());
       // stop();  // DON'T stop!
       TINY_GSM_YIELD();
       rx.clear();
@@ -339,6 +343,12 @@ class TinyGsmSaraR4 : public TinyGsmModem<TinyGsmSaraR4>,
     return (s == REG_OK_HOME || s == REG_OK_ROAMING);
   }
 
+  // +CIEV indicator events, which include the signal bars
+  bool signalReportsImpl(bool enable) {
+    sendAT(GF("+CMER=1,0,0,"), enable ? 2 : 0, GF(",1"));
+    return waitResponse() == 1;
+  }
+
  public:
   bool setURAT(uint8_t urat) {
     // AT+URAT=<SelectedAcT>[,<PreferredAct>[,<2ndPreferredAct>]]
@@ -505,64 +515,27 @@ class TinyGsmSaraR4 : public TinyGsmModem<TinyGsmSaraR4>,
     // +UULOC: <date>, <time>, <lat>, <long>, <alt>, <uncertainty>, <speed>,
     // <direction>, <vertical_acc>, <sensor_used>, <SV_used>, <antenna_status>,
     // <jamming_status>
+    // CellLocate stops after the uncertainty, leaving speed and SVs at 0
+    TinyGsmFields fields;
+    streamGetFields(fields);
 
-    // init variables
-    float ilat         = 0;
-    float ilon         = 0;
-    float ispeed       = 0;
-    float ialt         = 0;
-    int   iusat        = 0;
-    float iaccuracy    = 0;
-    int   iyear        = 0;
-    int   imonth       = 0;
-    int   iday         = 0;
-    int   ihour        = 0;
-    int   imin         = 0;
-    float secondWithSS = 0;
-
-    // Date & Time
-    iday         = streamGetIntBefore('/');    // Two digit day
-    imonth       = streamGetIntBefore('/');    // Two digit month
-    iyear        = streamGetIntBefore(',');    // Four digit year
-    ihour        = streamGetIntBefore(':');    // Two digit hour
-    imin         = streamGetIntBefore(':');    // Two digit minute
-    secondWithSS = streamGetFloatBefore(',');  // 6 digit second with subseconds
-
-    ilat = streamGetFloatBefore(',');  // Estimated latitude, in degrees
-    ilon = streamGetFloatBefore(',');  // Estimated longitude, in degrees
-    ialt = streamGetFloatBefore(
-        ',');         // Estimated altitude, in meters - only forGNSS
-                      // positioning, 0 in case of CellLocate
-    if (ialt != 0) {  // values not returned for CellLocate
-      iaccuracy =
-          streamGetFloatBefore(',');       // Maximum possible error, in meters
-      ispeed = streamGetFloatBefore(',');  // Speed over ground m/s3
-      streamSkipUntil(',');  // Course over ground in degree (0 deg - 360 deg)
-      streamSkipUntil(',');  // Vertical accuracy, in meters
-      streamSkipUntil(',');  // Sensor used for the position calculation
-      iusat = streamGetIntBefore(',');  // Number of satellite used
-      streamSkipUntil(',');             // Antenna status
-      streamSkipUntil('\n');            // Jamming status
-    } else {
-      iaccuracy =
-          streamGetFloatBefore('\n');  // Maximum possible error, in meters
-    }
+    int iyear = fields.number(0, 2, 0);  // Four digit year, after dd/MM/
+    if (iyear < 2000) iyear += 2000;
 
     // Set pointers
-    if (lat != NULL) *lat = ilat;
-    if (lon != NULL) *lon = ilon;
-    if (speed != NULL) *speed = ispeed;
-    if (alt != NULL) *alt = ialt;
+    if (lat != NULL) *lat = fields.toFloat(2);
+    if (lon != NULL) *lon = fields.toFloat(3);
+    if (speed != NULL) *speed = fields.toFloat(6, 0);
+    if (alt != NULL) *alt = fields.toFloat(4);
     if (vsat != NULL) *vsat = 0;  // Number of satellites viewed not reported;
-    if (usat != NULL) *usat = iusat;
-    if (accuracy != NULL) *accuracy = iaccuracy;
-    if (iyear < 2000) iyear += 2000;
+    if (usat != NULL) *usat = fields.toInt(10, 0);
+    if (accuracy != NULL) *accuracy = fields.toFloat(5);
     if (year != NULL) *year = iyear;
-    if (month != NULL) *month = imonth;
-    if (day != NULL) *day = iday;
-    if (hour != NULL) *hour = ihour;
-    if (minute != NULL) *minute = imin;
-    if (second != NULL) *second = static_cast<int>(secondWithSS);
+    if (month != NULL) *month = fields.number(0, 1, 0);
+    if (day != NULL) *day = fields.number(0, 0, 0);
+    if (hour != NULL) *hour = fields.number(1, 0, 0);
+    if (minute != NULL) *minute = fields.number(1, 1, 0);
+    if (second != NULL) *second = fields.number(1, 2, 0);
 
     // final ok
     waitResponse();
@@ -598,11 +571,11 @@ class TinyGsmSaraR4 : public TinyGsmModem<TinyGsmSaraR4>,
     sendAT(GF("+CIND?"));
     if (waitResponse(GF(GSM_NL "+CIND:")) != 1) { return 0; }
 
-    int8_t res     = streamGetIntBefore(',');
-    int8_t percent = res * 20;  // return is 0-5
+    TinyGsmFields fields;
+    streamGetFields(fields);
     // Wait for final OK
     waitResponse();
-    return percent;
+    return fields.toInt(0) * 20;  // return is 0-5
   }
 
   uint8_t getBattChargeStateImpl() TINY_GSM_ATTR_NOT_AVAILABLE;
@@ -719,7 +692,7 @@ class TinyGsmSaraR4 : public TinyGsmModem<TinyGsmSaraR4>,
     int16_t len = streamGetIntBefore(',');
     streamSkipUntil('\"');
 
-    for (int i = 0; i < len; i++) { moveCharFromStreamToFifo(mux); }
+    if (len > 0) { moveCharsFromStreamToFifo(mux, len); }
     streamSkipUntil('\"');
     waitResponse();
     // DBG("### READ:", len, "from", mux);
@@ -752,9 +725,10 @@ class TinyGsmSaraR4 : public TinyGsmModem<TinyGsmSaraR4>,
     uint8_t res = waitResponse(GF(GSM_NL "+USOCTL:"));
     if (res != 1) { return false; }
 
-    streamSkipUntil(',');  // Skip mux
-    streamSkipUntil(',');  // Skip type
-    int8_t result = streamGetIntBefore('\n');
+    // <socket>,<param_id>,<param_val>
+    TinyGsmFields fields;
+    streamGetFields(fields);
+    int8_t result = fields.toInt(2);
     // 0: the socket is in INACTIVE status (it corresponds to CLOSED status
     // defined in RFC793 "TCP Protocol Specification" [112])
     // 1: the socket is in LISTEN status
@@ -775,7 +749,6 @@ class TinyGsmSaraR4 : public TinyGsmModem<TinyGsmSaraR4>,
    * Utilities
    */
  public:
-  // TODO(vshymanskyy): Optimize this!
   int8_t waitResponse(uint32_t timeout_ms, String& data,
                       GsmConstStr r1 = GFP(GSM_OK),
                       GsmConstStr r2 = GFP(GSM_ERROR),
@@ -786,80 +759,7 @@ class TinyGsmSaraR4 : public TinyGsmModem<TinyGsmSaraR4>,
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    /*String r1s(r1); r1s.trim();
-    String r2s(r2); r2s.trim();
-    String r3s(r3); r3s.trim();
-    String r4s(r4); r4s.trim();
-    String r5s(r5); r5s.trim();
-    DBG("### ..:", r1s, ",", r2s, ",", r3s, ",", r4s, ",", r5s);*/
-    data.reserve(64);
-    uint8_t  index       = 0;
-    uint32_t startMillis = millis();
-    do {
-      TINY_GSM_YIELD();
-      while (stream.available() > 0) {
-        TINY_GSM_YIELD();
-        int8_t a = stream.read();
-        if (a <= 0) continue;  // Skip 0x00 bytes, just in case
-        data += static_cast<char>(a);
-        if (r1 && data.endsWith(r1)) {
-          index = 1;
-          goto finish;
-        } else if (r2 && data.endsWith(r2)) {
-          index = 2;
-          goto finish;
-        } else if (r3 && data.endsWith(r3)) {
-#if defined TINY_GSM_DEBUG
-          if (r3 == GFP(GSM_CME_ERROR)) {
-            streamSkipUntil('\n');  // Read out the error
-          }
-#endif
-          index = 3;
-          goto finish;
-        } else if (r4 && data.endsWith(r4)) {
-          index = 4;
-          goto finish;
-        } else if (r5 && data.endsWith(r5)) {
-          index = 5;
-          goto finish;
-        } else if (data.endsWith(GF("+UUSORD:"))) {
-          int8_t  mux = streamGetIntBefore(',');
-          int16_t len = streamGetIntBefore('\n');
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-            sockets[mux]->got_data = true;
-            // max size is 1024
-            if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
-          }
-          data = "";
-          DBG("### URC Data Received:", len, "on", mux);
-        } else if (data.endsWith(GF("+UUSOCL:"))) {
-          int8_t mux = streamGetIntBefore('\n');
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-            sockets[mux]->sock_connected = false;
-          }
-          data = "";
-          DBG("### URC Sock Closed: ", mux);
-        } else if (data.endsWith(GF("+UUSOCO:"))) {
-          int8_t mux          = streamGetIntBefore('\n');
-          int8_t socket_error = streamGetIntBefore('\n');
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux] &&
-              socket_error == 0) {
-            sockets[mux]->sock_connected = true;
-          }
-          data = "";
-          DBG("### URC Sock Opened: ", mux);
-        }
-      }
-    } while (millis() - startMillis < timeout_ms);
-  finish:
-    if (!index) {
-      data.trim();
-      if (data.length()) { DBG("### Unhandled:", data); }
-      data = "";
-    }
-    // data.replace(GSM_NL, "/");
-    // DBG('<', index, '>', data);
-    return index;
+    return parseResponse(timeout_ms, &data, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(uint32_t timeout_ms, GsmConstStr r1 = GFP(GSM_OK),
@@ -871,8 +771,7 @@ class TinyGsmSaraR4 : public TinyGsmModem<TinyGsmSaraR4>,
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    String data;
-    return waitResponse(timeout_ms, data, r1, r2, r3, r4, r5);
+    return parseResponse(timeout_ms, NULL, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(GsmConstStr r1 = GFP(GSM_OK),
@@ -887,6 +786,55 @@ class TinyGsmSaraR4 : public TinyGsmModem<TinyGsmSaraR4>,
     return waitResponse(1000, r1, r2, r3, r4, r5);
   }
 
+ protected:
+  // URCs, matched anywhere in the modem's output
+  static UrcTable urcTable() {
+    static constexpr Urc urcs[] TINY_GSM_PROGMEM = {
+        {"+UUSORD:", &TinyGsmSaraR4::onUuSoRd},
+        {"+UUSOCL:", &TinyGsmSaraR4::onUuSoCl},
+        {"+UUSOCO:", &TinyGsmSaraR4::onUuSoCo},
+        {GSM_NL "+CEREG:", &TinyGsmSaraR4::onCereg},
+        {GSM_NL "+CREG:", &TinyGsmSaraR4::onCreg},
+        {GSM_NL "+CGEV:", &TinyGsmSaraR4::onBearerEvent},
+        {GSM_NL "+CIEV:", &TinyGsmSaraR4::onIndicator},
+        {"", NULL}};
+    typedef TinyGsmTrie<TinyGsmTrieSize(urcs)> Trie;
+    static constexpr Trie trie TINY_GSM_PROGMEM = Trie::of(urcs);
+    return {urcs, trie.nodes};
+  }
+
+  bool onUuSoRd(UrcContext&) {
+    int8_t  mux = streamGetIntBefore(',');
+    int16_t len = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->got_data = true;
+      // max size is 1024
+      if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
+    }
+    DBG("### URC Data Received:", len, "on", mux);
+    return true;
+  }
+
+  bool onUuSoCl(UrcContext&) {
+    int8_t mux = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = false;
+    }
+    DBG("### URC Sock Closed: ", mux);
+    return true;
+  }
+
+  bool onUuSoCo(UrcContext&) {
+    int8_t mux          = streamGetIntBefore('\n');
+    int8_t socket_error = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux] &&
+        socket_error == 0) {
+      sockets[mux]->sock_connected = true;
+    }
+    DBG("### URC Sock Opened: ", mux);
+    return true;
+  }
+
  public:
   Stream& stream;
 
@@ -105,6 +105,7 @@ class TinyGsmSequansMonarch
 
    public:
     virtual int connect(const char* host, uint16_t port, int timeout_s) {
+      TINY_GSM_LOCK(at->commandLock());
       if (sock_connected) stop();
       TINY_GSM_YIELD();
       rx.clear();
@@ -114,6 +115,8 @@ class TinyGsmSequansMonarch
     TINY_GSM_CLIENT_CONNECT_OVERRIDES
 
     void stop(uint32_t maxWaitMs) {
+      TINY_GSM_LOCK(at->commandLock());
+      endTx();
       dumpModemBuffer(maxWaitMs);
       at->sendAT(GF("+SQNSH="), mux);
       sock_connected = false;
@@ -147,6 +150,7 @@ class TinyGsmSequansMonarch
 
    public:
     int connect(const char* host, uint16_t port, int timeout_s) override {
+      TINY_GSM_LOCK(at->commandLock());
       stop();
       TINY_GSM_YIELD();
       rx.clear();
@@ -544,15 +548,8 @@ class TinyGsmSequansMonarch
     if (waitResponse(GF("+SQNSRECV: ")) != 1) { return 0; }
     streamSkipUntil(',');  // Skip mux
     int16_t len = streamGetIntBefore('\n');
-    for (int i = 0; i < len; i++) {
-      uint32_t startMillis = millis();
-      while (!stream.available() &&
-             ((millis() - startMillis) <
-              sockets[mux % TINY_GSM_MUX_COUNT]->_timeout)) {
-        TINY_GSM_YIELD();
-      }
-      char c = stream.read();
-      sockets[mux % TINY_GSM_MUX_COUNT]->rx.put(c);
+    if (len > 0) {
+      moveCharsFromStreamToFifo(mux % TINY_GSM_MUX_COUNT, len);
     }
     // DBG("### READ:", len, "from", mux);
     waitResponse();
@@ -580,15 +577,13 @@ class TinyGsmSequansMonarch
     sendAT(GF("+SQNSS"));
     for (int muxNo = 1; muxNo <= TINY_GSM_MUX_COUNT; muxNo++) {
       if (waitResponse(GFP(GSM_OK), GF(GSM_NL "+SQNSS: ")) != 2) { break; }
-      uint8_t status = 0;
-      // if (streamGetIntBefore(',') != muxNo) { // check the mux no
+      // <mux>,<status>, then port and IP info if the mux is in use
+      TinyGsmFields fields;
+      streamGetFields(fields);
+      // if (fields.toInt(0) != muxNo) { // check the mux no
       //   DBG("### Warning: misaligned mux numbers!");
       // }
-      streamSkipUntil(',');        // skip mux [use muxNo]
-      status = stream.parseInt();  // Read the status
-      // if mux is in use, will have comma then other info after the status
-      // if not, there will be new line immediately after status
-      // streamSkipUntil('\n'); // Skip port and IP info
+      uint8_t status = fields.toInt(1, 0);  // Read the status
       // SOCK_CLOSED                 = 0,
       // SOCK_ACTIVE_DATA            = 1,
       // SOCK_SUSPENDED              = 2,
@@ -611,7 +606,6 @@ class TinyGsmSequansMonarch
    * Utilities
    */
  public:
-  // TODO(vshymanskyy): Optimize this!
   int8_t waitResponse(uint32_t timeout_ms, String& data,
                       GsmConstStr r1 = GFP(GSM_OK),
                       GsmConstStr r2 = GFP(GSM_ERROR),
@@ -622,72 +616,7 @@ class TinyGsmSequansMonarch
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    /*String r1s(r1); r1s.trim();
-    String r2s(r2); r2s.trim();
-    String r3s(r3); r3s.trim();
-    String r4s(r4); r4s.trim();
-    String r5s(r5); r5s.trim();
-    DBG("### ..:", r1s, ",", r2s, ",", r3s, ",", r4s, ",", r5s);*/
-    data.reserve(64);
-    uint8_t  index       = 0;
-    uint32_t startMillis = millis();
-    do {
-      TINY_GSM_YIELD();
-      while (stream.available() > 0) {
-        TINY_GSM_YIELD();
-        int8_t a = stream.read();
-        if (a <= 0) continue;  // Skip 0x00 bytes, just in case
-        data += static_cast<char>(a);
-        if (r1 && data.endsWith(r1)) {
-          index = 1;
-          goto finish;
-        } else if (r2 && data.endsWith(r2)) {
-          index = 2;
-          goto finish;
-        } else if (r3 && data.endsWith(r3)) {
-#if defined TINY_GSM_DEBUG
-          if (r3 == GFP(GSM_CME_ERROR)) {
-            streamSkipUntil('\n');  // Read out the error
-          }
-#endif
-          index = 3;
-          goto finish;
-        } else if (r4 && data.endsWith(r4)) {
-          index = 4;
-          goto finish;
-        } else if (r5 && data.endsWith(r5)) {
-          index = 5;
-          goto finish;
-        } else if (data.endsWith(GF(GSM_NL "+SQNSRING:"))) {
-          int8_t  mux = streamGetIntBefore(',');
-          int16_t len = streamGetIntBefore('\n');
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT &&
-              sockets[mux % TINY_GSM_MUX_COUNT]) {
-            sockets[mux % TINY_GSM_MUX_COUNT]->got_data       = true;
-            sockets[mux % TINY_GSM_MUX_COUNT]->sock_available = len;
-          }
-          data = "";
-          DBG("### URC Data Received:", len, "on", mux);
-        } else if (data.endsWith(GF("SQNSH: "))) {
-          int8_t mux = streamGetIntBefore('\n');
-          if (mux >= 0 && mux < TINY_GSM_MUX_COUNT &&
-              sockets[mux % TINY_GSM_MUX_COUNT]) {
-            sockets[mux % TINY_GSM_MUX_COUNT]->sock_connected = false;
-          }
-          data = "";
-          DBG("### URC Sock Closed: ", mux);
-        }
-      }
-    } while (millis() - startMillis < timeout_ms);
-  finish:
-    if (!index) {
-      data.trim();
-      if (data.length()) { DBG("### Unhandled:", data); }
-      data = "";
-    }
-    // data.replace(GSM_NL, "/");
-    // DBG('<', index, '>', data);
-    return index;
+    return parseResponse(timeout_ms, &data, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(uint32_t timeout_ms, GsmConstStr r1 = GFP(GSM_OK),
@@ -699,8 +628,7 @@ class TinyGsmSequansMonarch
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    String data;
-    return waitResponse(timeout_ms, data, r1, r2, r3, r4, r5);
+    return parseResponse(timeout_ms, NULL, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(GsmConstStr r1 = GFP(GSM_OK),
@@ -715,6 +643,42 @@ class TinyGsmSequansMonarch
     return waitResponse(1000, r1, r2, r3, r4, r5);
   }
 
+ protected:
+  // URCs, matched anywhere in the modem's output
+  static UrcTable urcTable() {
+    static constexpr Urc urcs[] TINY_GSM_PROGMEM = {
+        {GSM_NL "+SQNSRING:", &TinyGsmSequansMonarch::onSqnsRing},
+        {"SQNSH: ", &TinyGsmSequansMonarch::onSqnsh},
+        {GSM_NL "+CEREG:", &TinyGsmSequansMonarch::onCereg},
+        {GSM_NL "+CGEV:", &TinyGsmSequansMonarch::onBearerEvent},
+        {"", NULL}};
+    typedef TinyGsmTrie<TinyGsmTrieSize(urcs)> Trie;
+    static constexpr Trie trie TINY_GSM_PROGMEM = Trie::of(urcs);
+    return {urcs, trie.nodes};
+  }
+
+  bool onSqnsRing(UrcContext&) {
+    int8_t  mux = streamGetIntBefore(',');
+    int16_t len = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT &&
+        sockets[mux % TINY_GSM_MUX_COUNT]) {
+      sockets[mux % TINY_GSM_MUX_COUNT]->got_data       = true;
+      sockets[mux % TINY_GSM_MUX_COUNT]->sock_available = len;
+    }
+    DBG("### URC Data Received:", len, "on", mux);
+    return true;
+  }
+
+  bool onSqnsh(UrcContext&) {
+    int8_t mux = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT &&
+        sockets[mux % TINY_GSM_MUX_COUNT]) {
+      sockets[mux % TINY_GSM_MUX_COUNT]->sock_connected = false;
+    }
+    DBG("### URC Sock Closed: ", mux);
+    return true;
+  }
+
  public:
   Stream& stream;
 
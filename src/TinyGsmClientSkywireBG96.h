@@ -15,6 +15,13 @@
 #define TINY_GSM_MUX_COUNT 12
 #define TINY_GSM_BUFFER_READ_AND_CHECK_SIZE
 
+// Room a client in direct push mode keeps in its receive buffer: a push
+// brings up to 1500 bytes, and one more may be on its way by the time the
+// client has gone back to buffer mode
+#if !defined(TINY_GSM_PUSH_RESERVE)
+#define TINY_GSM_PUSH_RESERVE 3000
+#endif
+
 #include "TinyGsmBattery.tpp"
 #include "TinyGsmCalling.tpp"
 #include "TinyGsmGPRS.tpp"
@@ -82,6 +89,8 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
       prev_check     = 0;
       sock_connected = false;
       got_data       = false;
+      direct_push    = false;
+      pushing        = false;
 
       if (mux < TINY_GSM_MUX_COUNT) {
         this->mux = mux;
@@ -95,6 +104,7 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
 
    public:
     virtual int connect(const char* host, uint16_t port, int timeout_s) {
+      TINY_GSM_LOCK(at->commandLock());
       stop();
       TINY_GSM_YIELD();
       rx.clear();
@@ -104,6 +114,8 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
     TINY_GSM_CLIENT_CONNECT_OVERRIDES
 
     void stop(uint32_t maxWaitMs) {
+      TINY_GSM_LOCK(at->commandLock());
+      endTx();
       uint32_t startMillis = millis();
       dumpModemBuffer(maxWaitMs); 
       at->sendAT(GF("+QICLOSE="), mux);
@@ -115,6 +127,7 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
     }
 
     void stopSsl(uint32_t maxWaitMs) {
+      endTx();
       uint32_t startMillis = millis();
       dumpModemBuffer(maxWaitMs); 
       at->sendAT(GF("+QSSLCLOSE="), mux);
@@ -125,11 +138,25 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
     //  stopSsl(15000L);
     //}
 
+    // From the next connect(), has the modem push what arrives on the
+    // connection straight into the receive buffer (access mode 1, "direct
+    // push") instead of holding it until asked.  Needs a receive buffer of
+    // at least TINY_GSM_PUSH_RESERVE bytes (see setRxBuffer()); while it
+    // has less room than that the modem holds the data as usual.  Not for
+    // SSL connections.
+    void setDirectPush(bool enable) {
+      direct_push = enable;
+    }
+
     /*
      * Extended API
      */
 
     String remoteIP() TINY_GSM_ATTR_NOT_IMPLEMENTED;
+
+   protected:
+    bool direct_push;  // asked for with setDirectPush()
+    bool pushing;      // the modem pushes the data now
   };
 
   /*
@@ -148,6 +175,7 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
 
   public:
     int connect(const char* host, uint16_t port, int timeout_s) override {
+      TINY_GSM_LOCK(at->commandLock());
       stop();
       TINY_GSM_YIELD();
       rx.clear();
@@ -263,6 +291,12 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
     return (s == REG_OK_HOME || s == REG_OK_ROAMING);
   }
 
+  // +QIND: "csq" reports, on every change of the signal
+  bool signalReportsImpl(bool enable) {
+    sendAT(GF("+QINDCFG=\"csq\","), enable);
+    return waitResponse() == 1;
+  }
+
   /*
    * GPRS functions
    */
@@ -366,59 +400,30 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
       return false;
     }
 
-    // init variables
-    float ilat         = 0;
-    float ilon         = 0;
-    float ispeed       = 0;
-    float ialt         = 0;
-    int   iusat        = 0;
-    float iaccuracy    = 0;
-    int   iyear        = 0;
-    int   imonth       = 0;
-    int   iday         = 0;
-    int   ihour        = 0;
-    int   imin         = 0;
-    float secondWithSS = 0;
-
-    // UTC date & Time
-    ihour        = streamGetIntLength(2);      // Two digit hour
-    imin         = streamGetIntLength(2);      // Two digit minute
-    secondWithSS = streamGetFloatBefore(',');  // 6 digit second with subseconds
-
-    ilat      = streamGetFloatBefore(',');  // Latitude
-    ilon      = streamGetFloatBefore(',');  // Longitude
-    iaccuracy = streamGetFloatBefore(',');  // Horizontal precision
-    ialt      = streamGetFloatBefore(',');  // Altitude from sea level
-    streamSkipUntil(',');                   // GNSS positioning mode
-    streamSkipUntil(',');  // Course Over Ground based on true north
-    streamSkipUntil(',');  // Speed Over Ground in Km/h
-    ispeed = streamGetFloatBefore(',');  // Speed Over Ground in knots
-
-    iday   = streamGetIntLength(2);    // Two digit day
-    imonth = streamGetIntLength(2);    // Two digit month
-    iyear  = streamGetIntBefore(',');  // Two digit year
-
-    iusat = streamGetIntBefore(',');  // Number of satellites,
-    streamSkipUntil('\n');  // The error code of the operation. If it is not
-                            // 0, it is the type of error.
+    // UTC time (hhmmss.sss), latitude, longitude, horizontal precision,
+    // altitude, positioning mode, course over ground, speed over ground in
+    // km/h and in knots, date (ddMMyy), number of satellites
+    TinyGsmFields fields;
+    streamGetFields(fields);
+    waitResponse();  // Final OK
+
+    int iyear = fields.digits(9, 4, 2);  // Two digit year
+    if (iyear < 2000) iyear += 2000;
 
     // Set pointers
-    if (lat != NULL) *lat = ilat;
-    if (lon != NULL) *lon = ilon;
-    if (speed != NULL) *speed = ispeed;
-    if (alt != NULL) *alt = ialt;
+    if (lat != NULL) *lat = fields.toFloat(1);
+    if (lon != NULL) *lon = fields.toFloat(2);
+    if (speed != NULL) *speed = fields.toFloat(8);
+    if (alt != NULL) *alt = fields.toFloat(4);
     if (vsat != NULL) *vsat = 0;
-    if (usat != NULL) *usat = iusat;
-    if (accuracy != NULL) *accuracy = iaccuracy;
-    if (iyear < 2000) iyear += 2000;
+    if (usat != NULL) *usat = fields.toInt(10);
+    if (accuracy != NULL) *accuracy = fields.toFloat(3);
     if (year != NULL) *year = iyear;
-    if (month != NULL) *month = imonth;
-    if (day != NULL) *day = iday;
-    if (hour != NULL) *hour = ihour;
-    if (minute != NULL) *minute = imin;
-    if (second != NULL) *second = static_cast<int>(secondWithSS);
-
-    waitResponse();  // Final OK
+    if (month != NULL) *month = fields.digits(9, 2, 2);
+    if (day != NULL) *day = fields.digits(9, 0, 2);
+    if (hour != NULL) *hour = fields.digits(0, 0, 2);
+    if (minute != NULL) *minute = fields.digits(0, 2, 2);
+    if (second != NULL) *second = fields.digits(0, 4, 2);
     return true;
   }
 
@@ -450,27 +455,19 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
   bool getNetworkTimeImpl(int* year, int* month, int* day, int* hour,
                           int* minute, int* second, float* timezone) {
     sendAT(GF("+QLTS=2"));
-    if (waitResponse(2000L, GF("+QLTS: \"")) != 1) { return false; }
-
-    int iyear     = 0;
-    int imonth    = 0;
-    int iday      = 0;
-    int ihour     = 0;
-    int imin      = 0;
-    int isec      = 0;
-    int itimezone = 0;
-
-    // Date & Time
-    iyear       = streamGetIntBefore('/');
-    imonth      = streamGetIntBefore('/');
-    iday        = streamGetIntBefore(',');
-    ihour       = streamGetIntBefore(':');
-    imin        = streamGetIntBefore(':');
-    isec        = streamGetIntLength(2);
-    char tzSign = stream.read();
-    itimezone   = streamGetIntBefore(',');
-    if (tzSign == '-') { itimezone = itimezone * -1; }
-    streamSkipUntil('\n');  // DST flag
+    if (waitResponse(2000L, GF("+QLTS:")) != 1) { return false; }
+
+    // "yyyy/MM/dd,hh:mm:ss+zz,d", the time zone in quarters of an hour and
+    // the DST flag last
+    TinyGsmFields fields;
+    streamGetFields(fields);
+    int iyear     = fields.number(0, 0, 0);
+    int imonth    = fields.number(0, 1, 0);
+    int iday      = fields.number(0, 2, 0);
+    int ihour     = fields.number(0, 3, 0);
+    int imin      = fields.number(0, 4, 0);
+    int isec      = fields.number(0, 5, 0);
+    int itimezone = fields.number(0, 6, 0);
 
     // Set pointers
     if (iyear < 2000) iyear += 2000;
@@ -523,6 +520,7 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
     }
 
     uint32_t timeout_ms = ((uint32_t)timeout_s) * 1000;
+    bool     push       = !ssl && modemCanPush(mux);
 
     if (ssl) {
       // <PDPContextID>(1-16), <SSLContextID>(0-5),
@@ -534,9 +532,9 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
     else {
       // <PDPcontextID>(1-16), <connectID>(0-11),
       // "TCP/UDP/TCP LISTENER/UDPSERVICE", "<IP_address>/<domain_name>",
-      // <remote_port>,<local_port>,<access_mode>(0-2; 0=buffer)
+      // <remote_port>,<local_port>,<access_mode>(0-2; 0=buffer, 1=push)
       sendAT(GF("+QIOPEN=1,"), mux, GF(",\""), GF("TCP"), GF("\",\""), host,
-            GF("\","), port, GF(",0,0"));
+            GF("\","), port, GF(",0,"), push ? 1 : 0);
     }
     waitResponse();
 
@@ -549,7 +547,9 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
 
     if (streamGetIntBefore(',') != mux) { return false; }
     // Read status
-    return (0 == streamGetIntBefore('\n'));
+    bool connected = 0 == streamGetIntBefore('\n');
+    if (sockets[mux]) { sockets[mux]->pushing = connected && push; }
+    return connected;
   }
 
   int16_t modemSend(const void* buff, size_t len, uint8_t mux) {
@@ -580,7 +580,7 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
       if (waitResponse(GF("+QSSLRECV:")) != 1) { return 0; }
       int16_t len = streamGetIntBefore('\n');
 
-      for (int i = 0; i < len; i++) { moveCharFromStreamToFifo(mux); }
+      if (len > 0) { moveCharsFromStreamToFifo(mux, len); }
       waitResponse();
       // DBG("### READ:", len, "from", mux);
       sockets[mux]->sock_available = modemGetAvailable(mux);
@@ -592,7 +592,7 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
       if (waitResponse(GF("+QIRD:")) != 1) { return 0; }
       int16_t len = streamGetIntBefore('\n');
 
-      for (int i = 0; i < len; i++) { moveCharFromStreamToFifo(mux); }
+      if (len > 0) { moveCharsFromStreamToFifo(mux, len); }
       waitResponse();
       // DBG("### READ:", len, "from", mux);
       sockets[mux]->sock_available = modemGetAvailable(mux);
@@ -617,6 +617,8 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
     }
     else {
       if (!sockets[mux]) return 0;
+      // Pushed data is in the client already, until it has no room for more
+      if (sockets[mux]->pushing && !modemStopPush(mux)) { return 0; }
       sendAT(GF("+QIRD="), mux, GF(",0"));
       size_t result = 0;
       if (waitResponse(GF("+QIRD:")) == 1) {
@@ -626,11 +628,49 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
         if (result) { DBG("### DATA AVAILABLE:", result, "on", mux); }
         waitResponse();
       }
-      if (!result) { sockets[mux]->sock_connected = modemGetConnected(mux); }
+      if (!result) {
+        sockets[mux]->sock_connected = modemGetConnected(mux);
+        modemResumePush(mux);
+      }
       return result;
     }
   }
 
+  // Goes back to buffer mode if the client's receive buffer is short of
+  // TINY_GSM_PUSH_RESERVE bytes.  Returns true once in buffer mode.
+  bool modemStopPush(uint8_t mux) {
+    if (sockets[mux]->rx.free() >= TINY_GSM_PUSH_RESERVE) { return false; }
+    return modemSetPush(mux, false);
+  }
+
+  // Whether the socket is to be in direct push mode: it was asked for, and
+  // its receive buffer has room for what the modem pushes
+  bool modemCanPush(uint8_t mux) {
+    GsmClientSkywireBG96* sock = sockets[mux];
+    return sock && sock->direct_push &&
+           sock->rx.free() >= TINY_GSM_PUSH_RESERVE;
+  }
+
+  // Goes back to direct push, if it can, once the modem holds nothing more
+  // for the socket
+  void modemResumePush(uint8_t mux) {
+    GsmClientSkywireBG96* sock = sockets[mux];
+    if (sock->pushing || !sock->sock_connected || !modemCanPush(mux)) {
+      return;
+    }
+    sock->got_data = false;
+    if (!modemSetPush(mux, true) || !sock->got_data) { return; }
+    // Data came in while switching, and may still be held: read it first
+    modemSetPush(mux, false);
+  }
+
+  bool modemSetPush(uint8_t mux, bool push) {
+    sendAT(GF("+QISWTMD="), mux, ',', push ? 1 : 0);
+    if (waitResponse() != 1) { return false; }
+    sockets[mux]->pushing = push;
+    return true;
+  }
+
   bool modemGetConnected(uint8_t mux) {
     if (ssl) {
     sendAT(GF("+QSSLSTATE="), mux);
@@ -640,12 +680,9 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
 
       if (waitResponse(GF("+QISTATE:")) != 1) { return false; }
 
-      streamSkipUntil(',');                  // Skip mux
-      streamSkipUntil(',');                  // Skip socket type
-      streamSkipUntil(',');                  // Skip remote ip
-      streamSkipUntil(',');                  // Skip remote port
-      streamSkipUntil(',');                  // Skip local port
-      int8_t res = streamGetIntBefore(',');  // socket state
+      TinyGsmFields fields;
+      streamGetFields(fields);
+      int8_t res = fields.toInt(5);  // socket state
 
       waitResponse();
 
@@ -658,12 +695,9 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
 
       if (waitResponse(GF("+QISTATE:")) != 1) { return false; }
 
-      streamSkipUntil(',');                  // Skip mux
-      streamSkipUntil(',');                  // Skip socket type
-      streamSkipUntil(',');                  // Skip remote ip
-      streamSkipUntil(',');                  // Skip remote port
-      streamSkipUntil(',');                  // Skip local port
-      int8_t res = streamGetIntBefore(',');  // socket state
+      TinyGsmFields fields;
+      streamGetFields(fields);
+      int8_t res = fields.toInt(5);  // socket state
 
       waitResponse();
 
@@ -676,7 +710,6 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
    * Utilities
    */
  public:
-  // TODO(vshymanskyy): Optimize this!
   int8_t waitResponse(uint32_t timeout_ms, String& data,
                       GsmConstStr r1 = GFP(GSM_OK),
                       GsmConstStr r2 = GFP(GSM_ERROR),
@@ -687,74 +720,7 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    /*String r1s(r1); r1s.trim();
-    String r2s(r2); r2s.trim();
-    String r3s(r3); r3s.trim();
-    String r4s(r4); r4s.trim();
-    String r5s(r5); r5s.trim();
-    DBG("### ..:", r1s, ",", r2s, ",", r3s, ",", r4s, ",", r5s);*/
-    data.reserve(64);
-    uint8_t  index       = 0;
-    uint32_t startMillis = millis();
-    do {
-      TINY_GSM_YIELD();
-      while (stream.available() > 0) {
-        TINY_GSM_YIELD();
-        int8_t a = stream.read();
-        if (a <= 0) continue;  // Skip 0x00 bytes, just in case
-        data += static_cast<char>(a);
-        if (r1 && data.endsWith(r1)) {
-          index = 1;
-          goto finish;
-        } else if (r2 && data.endsWith(r2)) {
-          index = 2;
-          goto finish;
-        } else if (r3 && data.endsWith(r3)) {
-#if defined TINY_GSM_DEBUG
-          if (r3 == GFP(GSM_CME_ERROR)) {
-            streamSkipUntil('\n');  // Read out the error
-          }
-#endif
-          index = 3;
-          goto finish;
-        } else if (r4 && data.endsWith(r4)) {
-          index = 4;
-          goto finish;
-        } else if (r5 && data.endsWith(r5)) {
-          index = 5;
-          goto finish;
-        } else if (data.endsWith(GF(GSM_NL "+QIURC:"))) {
-          streamSkipUntil('\"');
-          String urc = stream.readStringUntil('\"');
-          streamSkipUntil(',');
-          if (urc == "recv") {
-            int8_t mux = streamGetIntBefore('\n');
-            DBG("### URC RECV:", mux);
-            if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-              sockets[mux]->got_data = true;
-            }
-          } else if (urc == "closed") {
-            int8_t mux = streamGetIntBefore('\n');
-            DBG("### URC CLOSE:", mux);
-            if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-              sockets[mux]->sock_connected = false;
-            }
-          } else {
-            streamSkipUntil('\n');
-          }
-          data = "";
-        }
-      }
-    } while (millis() - startMillis < timeout_ms);
-  finish:
-    if (!index) {
-      data.trim();
-      if (data.length()) { DBG("### Unhandled:", data); }
-      data = "";
-    }
-    // data.replace(GSM_NL, "/");
-    // DBG('<', index, '>', data);
-    return index;
+    return parseResponse(timeout_ms, &data, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(uint32_t timeout_ms, GsmConstStr r1 = GFP(GSM_OK),
@@ -766,8 +732,7 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    String data;
-    return waitResponse(timeout_ms, data, r1, r2, r3, r4, r5);
+    return parseResponse(timeout_ms, NULL, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(GsmConstStr r1 = GFP(GSM_OK),
@@ -782,6 +747,64 @@ class TinyGsmSkywireBG96 : public TinyGsmModem<TinyGsmSkywireBG96>,
     return waitResponse(1000, r1, r2, r3, r4, r5);
   }
 
+ protected:
+  // URCs, matched anywhere in the modem's output
+  static UrcTable urcTable() {
+    static constexpr Urc urcs[] TINY_GSM_PROGMEM = {
+        {GSM_NL "+QIURC:", &TinyGsmSkywireBG96::onQiUrc},
+        {GSM_NL "+CEREG:", &TinyGsmSkywireBG96::onCereg},
+        {GSM_NL "+CREG:", &TinyGsmSkywireBG96::onCreg},
+        {GSM_NL "+CGEV:", &TinyGsmSkywireBG96::onBearerEvent},
+        {GSM_NL "+QIND: \"csq\",", &TinyGsmSkywireBG96::onSignalReport},
+        {"", NULL}};
+    typedef TinyGsmTrie<TinyGsmTrieSize(urcs)> Trie;
+    static constexpr Trie trie TINY_GSM_PROGMEM = Trie::of(urcs);
+    return {urcs, trie.nodes};
+  }
+
+  void modemTakePush(uint8_t mux, int16_t len) {
+    GsmClientSkywireBG96* sock = sockets[mux];
+    size_t                lost = len - moveCharsFromStreamToFifo(mux, len);
+    if (lost) {
+      DBG("### Push overflow:", lost, "bytes lost on", mux);
+      sock->rx_lost += lost;
+    }
+    // Low on room: the next command, from maintain() at the latest, takes
+    // the socket back to buffer mode
+    if (sock->rx.free() < TINY_GSM_PUSH_RESERVE) { sock->got_data = true; }
+  }
+
+  // The modem pushes whether or not there is room, also while it answers a
+  // command: a client low on room goes back to buffer mode first
+  void beforeCommandImpl() {
+    for (int mux = 0; mux < TINY_GSM_MUX_COUNT; mux++) {
+      GsmClientSkywireBG96* sock = sockets[mux];
+      if (!sock || !sock->pushing ||
+          sock->rx.free() >= TINY_GSM_PUSH_RESERVE) {
+        continue;
+      }
+      sock->pushing = false;  // Not to be switched again by its own command
+      if (!modemSetPush(mux, false)) { sock->pushing = true; }
+    }
+  }
+
+  // Pushes taken when idle could overflow a client low on room: leave them
+  // on the line until the next command has the client in buffer mode
+  bool holdUrcsImpl() {
+    for (int mux = 0; mux < TINY_GSM_MUX_COUNT; mux++) {
+      GsmClientSkywireBG96* sock = sockets[mux];
+      if (sock && sock->pushing &&
+          sock->rx.free() < TINY_GSM_PUSH_RESERVE) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool onQiUrc(UrcContext&) {
+    return takeQiUrc();
+  }
+
  public:
   Stream& stream;
 
@@ -96,6 +96,7 @@ class TinyGsmSkywireNano : public TinyGsmModem<TinyGsmSkywireNano>,
 
    public:
     virtual int connect(const char* host, uint16_t port, int timeout_s) {
+      TINY_GSM_LOCK(at->commandLock());
       stop();
       TINY_GSM_YIELD();
       rx.clear();
@@ -105,6 +106,8 @@ class TinyGsmSkywireNano : public TinyGsmModem<TinyGsmSkywireNano>,
     TINY_GSM_CLIENT_CONNECT_OVERRIDES
 
     void stop(uint32_t maxWaitMs) {
+      TINY_GSM_LOCK(at->commandLock());
+      endTx();
       uint32_t startMillis = millis();
       dumpModemBuffer(maxWaitMs); 
       at->sendAT(GF("#XSOCKET="), mux, GF(",0"));
@@ -116,6 +119,7 @@ class TinyGsmSkywireNano : public TinyGsmModem<TinyGsmSkywireNano>,
     }
 
     void stopSsl(uint32_t maxWaitMs) {
+      endTx();
       uint32_t startMillis = millis();
       dumpModemBuffer(maxWaitMs); 
       at->sendAT(GF("#XTLSSOCKET="), mux, GF(",0"));
@@ -149,6 +153,7 @@ class TinyGsmSkywireNano : public TinyGsmModem<TinyGsmSkywireNano>,
 
   public:
     int connect(const char* host, uint16_t port, int timeout_s) override {
+      TINY_GSM_LOCK(at->commandLock());
       stop();
       TINY_GSM_YIELD();
       rx.clear();
@@ -441,27 +446,18 @@ bool sleepEnableImpl(bool enable = true) {
   bool getNetworkTimeImpl(int* year, int* month, int* day, int* hour,
                           int* minute, int* second, float* timezone) {
     sendAT(GF("+CCLK"));
-    if (waitResponse(2000L, GF("+CCLK: \"")) != 1) { return false; }
-
-    int iyear     = 0;
-    int imonth    = 0;
-    int iday      = 0;
-    int ihour     = 0;
-    int imin      = 0;
-    int isec      = 0;
-    int itimezone = 0;
-
-    // Date & Time
-    iyear       = streamGetIntBefore('/');
-    imonth      = streamGetIntBefore('/');
-    iday        = streamGetIntBefore(',');
-    ihour       = streamGetIntBefore(':');
-    imin        = streamGetIntBefore(':');
-    isec        = streamGetIntLength(2);
-    char tzSign = stream.read();
-    itimezone   = streamGetIntBefore(',');
-    if (tzSign == '-') { itimezone = itimezone * -1; }
-    streamSkipUntil('\n');  // DST flag
+    if (waitResponse(2000L, GF("+CCLK:")) != 1) { return false; }
+
+    // "yy/MM/dd,hh:mm:ss+zz", the time zone in quarters of an hour
+    TinyGsmFields fields;
+    streamGetFields(fields);
+    int iyear     = fields.number(0, 0, 0);
+    int imonth    = fields.number(0, 1, 0);
+    int iday      = fields.number(0, 2, 0);
+    int ihour     = fields.number(0, 3, 0);
+    int imin      = fields.number(0, 4, 0);
+    int isec      = fields.number(0, 5, 0);
+    int itimezone = fields.number(0, 6, 0);
 
     // Set pointers
     if (iyear < 2000) iyear += 2000;
@@ -593,7 +589,7 @@ bool sleepEnableImpl(bool enable = true) {
       if (waitResponse(GF("+QIRD:")) != 1) { return 0; }
       int16_t len = streamGetIntBefore('\n');
 
-      for (int i = 0; i < len; i++) { moveCharFromStreamToFifo(mux); }
+      if (len > 0) { moveCharsFromStreamToFifo(mux, len); }
       waitResponse();
       // DBG("### READ:", len, "from", mux);
       sockets[mux]->sock_available = modemGetAvailable(mux);
@@ -605,7 +601,7 @@ bool sleepEnableImpl(bool enable = true) {
     if (len == 0) { return 0; }
     len = streamGetIntBefore(',');
 
-    for (int i = 0; i < len; i++) { moveCharFromStreamToFifo(mux); }
+    if (len > 0) { moveCharsFromStreamToFifo(mux, len); }
     waitResponse();
     DBG("### READ:", len, "from", mux);
     sockets[mux]->sock_available = modemGetAvailable(mux);
@@ -636,7 +632,6 @@ bool sleepEnableImpl(bool enable = true) {
    * Utilities
    */
  public:
-  // TODO(vshymanskyy): Optimize this!
   int8_t waitResponse(uint32_t timeout_ms, String& data,
                       GsmConstStr r1 = GFP(GSM_OK),
                       GsmConstStr r2 = GFP(GSM_ERROR),
@@ -647,74 +642,7 @@ bool sleepEnableImpl(bool enable = true) {
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    /*String r1s(r1); r1s.trim();
-    String r2s(r2); r2s.trim();
-    String r3s(r3); r3s.trim();
-    String r4s(r4); r4s.trim();
-    String r5s(r5); r5s.trim();
-    DBG("### ..:", r1s, ",", r2s, ",", r3s, ",", r4s, ",", r5s); */
-    data.reserve(64);
-    uint8_t  index       = 0;
-    uint32_t startMillis = millis();
-    do {
-      TINY_GSM_YIELD();
-      while (stream.available() > 0) {
-        TINY_GSM_YIELD();
-        int8_t a = stream.read();
-        if (a <= 0) continue;  // Skip 0x00 bytes, just in case
-        data += static_cast<char>(a);
-        if (r1 && data.endsWith(r1)) {
-          index = 1;
-          goto finish;
-        } else if (r2 && data.endsWith(r2)) {
-          index = 2;
-          goto finish;
-        } else if (r3 && data.endsWith(r3)) {
-#if defined TINY_GSM_DEBUG
-          if (r3 == GFP(GSM_CME_ERROR)) {
-            streamSkipUntil('\n');  // Read out the error
-          }
-#endif
-          index = 3;
-          goto finish;
-        } else if (r4 && data.endsWith(r4)) {
-          index = 4;
-          goto finish;
-        } else if (r5 && data.endsWith(r5)) {
-          index = 5;
-          goto finish;
-        } else if (data.endsWith(GF(GSM_NL "#URC:"))) {
-          streamSkipUntil('\"');
-          String urc = stream.readStringUntil('\"');
-          streamSkipUntil(',');
-          if (urc == "recv") {
-            int8_t mux = streamGetIntBefore('\n');
-            DBG("### URC RECV:", mux);
-            if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-              sockets[mux]->got_data = true;
-            }
-          } else if (urc == "closed") {
-            int8_t mux = streamGetIntBefore('\n');
-            DBG("### URC CLOSE:", mux);
-            if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-              sockets[mux]->sock_connected = false;
-            }
-          } else {
-            streamSkipUntil('\n');
-          }
-          data = "";
-        }
-      }
-    } while (millis() - startMillis < timeout_ms);
-  finish:
-    if (!index) {
-      data.trim();
-      if (data.length()) { DBG("### Unhandled:", data); }
-      data = "";
-    }
-    data.replace(GSM_NL, "/");
-    DBG('<', index, '>', data);
-    return index;
+    return parseResponse(timeout_ms, &data, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(uint32_t timeout_ms, GsmConstStr r1 = GFP(GSM_OK),
@@ -726,8 +654,7 @@ bool sleepEnableImpl(bool enable = true) {
                       GsmConstStr r3 = NULL, GsmConstStr r4 = NULL,
 #endif
                       GsmConstStr r5 = NULL) {
-    String data;
-    return waitResponse(timeout_ms, data, r1, r2, r3, r4, r5);
+    return parseResponse(timeout_ms, NULL, r1, r2, r3, r4, r5);
   }
 
   int8_t waitResponse(GsmConstStr r1 = GFP(GSM_OK),
@@ -748,6 +675,41 @@ bool sleepEnableImpl(bool enable = true) {
   #endif
   }
 
+ protected:
+  // URCs, matched anywhere in the modem's output
+  static UrcTable urcTable() {
+    static constexpr Urc urcs[] TINY_GSM_PROGMEM = {
+        {GSM_NL "#URC:", &TinyGsmSkywireNano::onUrc},
+        {GSM_NL "+CEREG:", &TinyGsmSkywireNano::onCereg},
+        {GSM_NL "+CGEV:", &TinyGsmSkywireNano::onBearerEvent},
+        {"", NULL}};
+    typedef TinyGsmTrie<TinyGsmTrieSize(urcs)> Trie;
+    static constexpr Trie trie TINY_GSM_PROGMEM = Trie::of(urcs);
+    return {urcs, trie.nodes};
+  }
+
+  bool onUrc(UrcContext&) {
+    streamSkipUntil('\"');
+    String urc = stream.readStringUntil('\"');
+    streamSkipUntil(',');
+    if (urc == "recv") {
+      int8_t mux = streamGetIntBefore('\n');
+      DBG("### URC RECV:", mux);
+      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+        sockets[mux]->got_data = true;
+      }
+    } else if (urc == "closed") {
+      int8_t mux = streamGetIntBefore('\n');
+      DBG("### URC CLOSE:", mux);
+      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+        sockets[mux]->sock_connected = false;
+      }
+    } else {
+      streamSkipUntil('\n');
+    }
+    return true;
+  }
+
  public:
   Stream& stream;
 
@@ -115,6 +115,7 @@ class TinyGsmXBee : public TinyGsmModem<TinyGsmXBee>,
     // are saved to flash, it is possible (or likely) that you could send data
     // even if you haven't "made" any connection.
     virtual int connect(const char* host, uint16_t port, int timeout_s) {
+      TINY_GSM_LOCK(at->commandLock());
       // NOTE:  Not caling stop() or yeild() here
       at->streamClear();  // Empty anything in the buffer before starting
       sock_connected = at->modemConnect(host, port, mux, false, timeout_s);
@@ -138,6 +139,7 @@ class TinyGsmXBee : public TinyGsmModem<TinyGsmXBee>,
     }
 
     void stop(uint32_t maxWaitMs) {
+      TINY_GSM_LOCK(at->commandLock());
       at->streamClear();  // Empty anything in the buffer
       // empty the saved currently-in-use destination address
       at->modemStop(maxWaitMs);
@@ -258,6 +260,7 @@ class TinyGsmXBee : public TinyGsmModem<TinyGsmXBee>,
 
    public:
     int connect(const char* host, uint16_t port, int timeout_s) override {
+      TINY_GSM_LOCK(at->commandLock());
       // NOTE:  Not caling stop() or yeild() here
       at->streamClear();  // Empty anything in the buffer before starting
       sock_connected = at->modemConnect(host, port, mux, true, timeout_s);
@@ -697,6 +700,12 @@ class TinyGsmXBee : public TinyGsmModem<TinyGsmXBee>,
     }
   }
 
+  bool getSignalSampleImpl(TinyGsmSignalSample& sample) {
+    sample      = TinyGsmSignalSample();
+    sample.rssi = getSignalQualityImpl();
+    return sample.rssi != 0;
+  }
+
   bool isNetworkConnectedImpl() {
     RegStatus s = getRegistrationStatus();
     if (s == REG_OK) {
@@ -712,6 +721,8 @@ class TinyGsmXBee : public TinyGsmModem<TinyGsmXBee>,
   }
 
   bool waitForNetworkImpl(uint32_t timeout_ms = 60000L) {
+    // Not a background request here, so it holds the lock throughout
+    TINY_GSM_LOCK(commandLock());
     bool retVal = false;
     XBEE_COMMAND_START_DECORATOR(5, false)
     for (uint32_t start = millis(); millis() - start < timeout_ms;) {
@@ -737,6 +748,11 @@ class TinyGsmXBee : public TinyGsmModem<TinyGsmXBee>,
     return IPaddr;
   }
 
+  // No bearer event reports to keep the bearer state by
+  bool bearerReportsImpl() {
+    return false;
+  }
+
   /*
    * WiFi functions
    */
@@ -880,6 +896,20 @@ class TinyGsmXBee : public TinyGsmModem<TinyGsmXBee>,
     return true;
   }
 
+  // Sending takes the XBee in and out of command mode, so it is one step
+  bool sendSMSRequestImpl(TinyGsmRequest& req, const char* number,
+                          const char* text) {
+    req.str[0] = number;
+    req.str[1] = text;
+    return startRequest(req, this, sendSMSStep);
+  }
+
+  static void sendSMSStep(void* owner, TinyGsmRequest& req) {
+    TinyGsmXBee* at = static_cast<TinyGsmXBee*>(owner);
+    req.finish(at->sendSMSImpl(req.str[0], req.str[1]) ? REQUEST_OK
+                                                         : REQUEST_FAILED);
+  }
+
   /*
    * Battery functions
    */
@@ -1129,7 +1159,7 @@ class TinyGsmXBee : public TinyGsmModem<TinyGsmXBee>,
   // after data has been sent on the socket.  If it returns 0xFF the socket may
   // really be open, but no data has yet been sent.  We return this unknown
   // value as true so there's a possibility it's wrong.
-  bool modemGetConnected() {
+  bool modemGetConnected(uint8_t = 0) {
     // If the IP address is 0, it's not valid so we can't be connected
     if (savedIP == IPAddress(0, 0, 0, 0)) { return false; }
 
@@ -1267,7 +1297,6 @@ class TinyGsmXBee : public TinyGsmModem<TinyGsmXBee>,
     }
   }
 
-  // TODO(vshymanskyy): Optimize this!
   // NOTE:  This function is used while INSIDE command mode, so we're only
   // waiting for requested responses.  The XBee has no unsoliliced responses
   // (URC's) when in command mode.
@@ -1281,6 +1310,7 @@ class TinyGsmXBee : public TinyGsmModem<TinyGsmXBee>,
     String r4s(r4); r4s.trim();
     String r5s(r5); r5s.trim();
     DBG("### ..:", r1s, ",", r2s, ",", r3s, ",", r4s, ",", r5s);*/
+    responseMatcher.expect(r1, r2, r3, r4, r5);
     data.reserve(16);  // Should never be getting much here for the XBee
     int8_t   index       = 0;
     uint32_t startMillis = millis();
@@ -1291,22 +1321,8 @@ class TinyGsmXBee : public TinyGsmModem<TinyGsmXBee>,
         int8_t a = stream.read();
         if (a <= 0) continue;  // Skip 0x00 bytes, just in case
         data += static_cast<char>(a);
-        if (r1 && data.endsWith(r1)) {
-          index = 1;
-          goto finish;
-        } else if (r2 && data.endsWith(r2)) {
-          index = 2;
-          goto finish;
-        } else if (r3 && data.endsWith(r3)) {
-          index = 3;
-          goto finish;
-        } else if (r4 && data.endsWith(r4)) {
-          index = 4;
-          goto finish;
-        } else if (r5 && data.endsWith(r5)) {
-          index = 5;
-          goto finish;
-        }
+        index = responseMatcher.feed(a);
+        if (index) goto finish;
       }
     } while (millis() - startMillis < timeout_ms);
   finish:
@@ -1436,6 +1452,15 @@ class TinyGsmXBee : public TinyGsmModem<TinyGsmXBee>,
     return res;
   }
 
+  // The XBee has no URCs; the empty table lets the shared response reader,
+  // which background requests go through, compile
+  static UrcTable urcTable() {
+    static constexpr Urc urcs[] TINY_GSM_PROGMEM = {{"", NULL}};
+    typedef TinyGsmTrie<TinyGsmTrieSize(urcs)> Trie;
+    static constexpr Trie trie TINY_GSM_PROGMEM = Trie::of(urcs);
+    return {urcs, trie.nodes};
+  }
+
   bool gotIPforSavedHost() {
     if (savedHost != "" && savedHostIP != IPAddress(0, 0, 0, 0))
       return true;
@@ -0,0 +1,376 @@
+/**
+ * @file       TinyGsmCoroutine.h
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Oct 2026
+ */
+
+#ifndef SRC_TINYGSMCOROUTINE_H_
+#define SRC_TINYGSMCOROUTINE_H_
+
+// C++20 coroutines over the modem's background requests, e.g.
+//
+//   #include <TinyGsmClient.h>
+//   #include <TinyGsmCoroutine.h>
+//
+//   TinyGsmExecutor<TinyGsm> exec(modem);
+//
+//   TinyGsmTask telemetry(TinyGsmClient& client) {
+//     bool ok = co_await exec.waitForNetwork();
+//     if (ok) { ok = co_await exec.connect(client, "example.com", 80); }
+//     if (!ok) { co_return; }
+//     for (;;) {
+//       co_await exec.write(client, data, sizeof(data));
+//       co_await exec.sleep(1000);
+//     }
+//   }
+//
+//   void setup() {
+//     exec.spawn(telemetry(client));
+//     exec.spawn(alerts());
+//   }
+//   void loop() {
+//     exec.runOnce();
+//     // ... other work ...
+//   }
+//
+// Tasks share the one modem: what they ask of it queues up as requests and
+// runs in turn, and a task waiting for the modem costs nothing but a check
+// per runOnce().  Operations that have no background form in the driver
+// (e.g. gprsConnect(), write()) run as one step of a request, so they still
+// take their turn, but block the loop for as long as they take.
+//
+// GCC 12 miscompiles a co_await in the condition of an if whose branch
+// co_returns, so keep the result in a variable first as above.
+
+#if !defined(__cpp_impl_coroutine)
+#error "TinyGsmCoroutine.h needs C++20 coroutines (-std=c++20)"
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+#include "TinyGsmRequest.h"
+
+// Most tasks an executor runs at once
+#ifndef TINY_GSM_CORO_TASKS
+#define TINY_GSM_CORO_TASKS 8
+#endif
+
+// Something a task waits for; the executor asks ready() on every runOnce()
+class TinyGsmAwaitable {
+ public:
+  virtual bool ready() = 0;
+
+ protected:
+  ~TinyGsmAwaitable() = default;
+};
+
+// A coroutine run by a TinyGsmExecutor.  It starts once spawned.
+class TinyGsmTask {
+ public:
+  struct promise_type {
+    TinyGsmAwaitable* waiting = nullptr;
+
+    TinyGsmTask get_return_object() {
+      return TinyGsmTask(Handle::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept {
+      return {};
+    }
+    std::suspend_always final_suspend() noexcept {
+      return {};
+    }
+    void return_void() {}
+    void unhandled_exception() {
+      std::terminate();
+    }
+  };
+  typedef std::coroutine_handle<promise_type> Handle;
+
+  TinyGsmTask(TinyGsmTask&& other) : _handle(other._handle) {
+    other._handle = nullptr;
+  }
+  ~TinyGsmTask() {
+    if (_handle) { _handle.destroy(); }
+  }
+
+  Handle release() {
+    return std::exchange(_handle, nullptr);
+  }
+
+ private:
+  explicit TinyGsmTask(Handle handle) : _handle(handle) {}
+
+  Handle _handle;
+};
+
+// Waits for a request that start() queues on the modem; true if it succeeded
+template <class Start>
+class TinyGsmRequestAwaiter : public TinyGsmAwaitable {
+ public:
+  explicit TinyGsmRequestAwaiter(Start start) : _start(start) {}
+
+  bool await_ready() {
+    return false;
+  }
+  bool await_suspend(TinyGsmTask::Handle task) {
+    if (!_start(_req)) { return false; }
+    task.promise().waiting = this;
+    return true;
+  }
+  bool await_resume() {
+    return _req.ok();
+  }
+  bool ready() override {
+    return !_req.busy();
+  }
+
+ private:
+  Start          _start;
+  TinyGsmRequest _req;
+};
+
+// Calls fn() as one step of a request on the modem; gives what fn() returned
+template <class Modem, class Fn>
+class TinyGsmDeferred : public TinyGsmAwaitable {
+ public:
+  TinyGsmDeferred(Modem& modem, Fn fn) : _modem(modem), _fn(fn), _result() {}
+
+  bool await_ready() {
+    return false;
+  }
+  bool await_suspend(TinyGsmTask::Handle task) {
+    if (!_modem.startRequest(_req, this, step)) { return false; }
+    task.promise().waiting = this;
+    return true;
+  }
+  auto await_resume() {
+    return _result;
+  }
+  bool ready() override {
+    return !_req.busy();
+  }
+
+ private:
+  static void step(void* owner, TinyGsmRequest& req) {
+    TinyGsmDeferred* self = static_cast<TinyGsmDeferred*>(owner);
+    self->_result         = self->_fn();
+    req.finish(REQUEST_OK);
+  }
+
+  Modem&                         _modem;
+  Fn                             _fn;
+  decltype(std::declval<Fn>()()) _result;
+  TinyGsmRequest                 _req;
+};
+
+// Resumes the task once ms have passed
+class TinyGsmSleep : public TinyGsmAwaitable {
+ public:
+  explicit TinyGsmSleep(uint32_t ms) : _start(millis()), _ms(ms) {}
+
+  bool await_ready() {
+    return !_ms;
+  }
+  void await_suspend(TinyGsmTask::Handle task) {
+    task.promise().waiting = this;
+  }
+  void await_resume() {}
+  bool ready() override {
+    return millis() - _start >= _ms;
+  }
+
+ private:
+  uint32_t _start;
+  uint32_t _ms;
+};
+
+// Waits until the client has data, is closed or timeout_ms has passed, then
+// reads what there is; gives the number of bytes read
+template <class Client>
+class TinyGsmReadAwaiter : public TinyGsmAwaitable {
+ public:
+  TinyGsmReadAwaiter(Client& client, uint8_t* buf, size_t len,
+                     uint32_t timeout_ms)
+      : _client(client),
+        _buf(buf),
+        _len(len),
+        _start(millis()),
+        _timeout_ms(timeout_ms) {}
+
+  bool await_ready() {
+    return ready();
+  }
+  void await_suspend(TinyGsmTask::Handle task) {
+    task.promise().waiting = this;
+  }
+  int await_resume() {
+    if (_client.available() <= 0) { return 0; }
+    int n = _client.read(_buf, _len);
+    return n > 0 ? n : 0;
+  }
+  bool ready() override {
+    return _client.available() > 0 || !_client.connected() ||
+        millis() - _start >= _timeout_ms;
+  }
+
+ private:
+  Client&  _client;
+  uint8_t* _buf;
+  size_t   _len;
+  uint32_t _start;
+  uint32_t _timeout_ms;
+};
+
+// Runs tasks on one modem.  Call runOnce() from the main loop, or run() to
+// go on until every task has finished.
+template <class Modem>
+class TinyGsmExecutor {
+ public:
+  // maintain() is called every maintain_ms to pick up URCs and socket data;
+  // on modems where it listens for a while (see maintainImpl()), make this
+  // longer
+  explicit TinyGsmExecutor(Modem& modem, uint32_t maintain_ms = 100)
+      : _modem(modem), _maintain_ms(maintain_ms), _maintained(millis()) {
+    for (uint8_t i = 0; i < TINY_GSM_CORO_TASKS; i++) { _tasks[i] = nullptr; }
+  }
+  ~TinyGsmExecutor() {
+    for (uint8_t i = 0; i < TINY_GSM_CORO_TASKS; i++) {
+      if (_tasks[i]) { _tasks[i].destroy(); }
+    }
+  }
+
+  // Takes the task over; false if TINY_GSM_CORO_TASKS are running already
+  bool spawn(TinyGsmTask&& task) {
+    for (uint8_t i = 0; i < TINY_GSM_CORO_TASKS; i++) {
+      if (!_tasks[i]) {
+        _tasks[i] = task.release();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  uint8_t tasks() const {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < TINY_GSM_CORO_TASKS; i++) {
+      if (_tasks[i]) { n++; }
+    }
+    return n;
+  }
+
+  // Advances the modem's requests, keeps up with URCs and resumes the tasks
+  // whose wait is over.  Returns true if any task ran.
+  bool runOnce() {
+    _pending = _modem.poll();
+    if (millis() - _maintained >= _maintain_ms) {
+      _modem.maintain();
+      _maintained = millis();
+    }
+    bool ran = false;
+    for (uint8_t i = 0; i < TINY_GSM_CORO_TASKS; i++) {
+      TinyGsmTask::Handle task = _tasks[i];
+      if (!task) { continue; }
+      TinyGsmAwaitable*& waiting = task.promise().waiting;
+      if (waiting && !waiting->ready()) { continue; }
+      waiting = nullptr;
+      task.resume();
+      ran = true;
+      if (task.done()) {
+        task.destroy();
+        _tasks[i] = nullptr;
+      }
+    }
+    return ran;
+  }
+
+  // Runs until every task has finished, idling a millisecond at a time when
+  // neither the tasks nor the modem have anything to do
+  void run() {
+    while (tasks()) {
+      if (runOnce()) { continue; }
+      TINY_GSM_YIELD();
+      if (!_pending) { delay(1); }
+    }
+  }
+
+  /*
+   * What tasks can co_await
+   */
+  TinyGsmSleep sleep(uint32_t ms) {
+    return TinyGsmSleep(ms);
+  }
+
+  // Calls fn() in turn with the modem's requests.  fn() may use the blocking
+  // API, except for what runs a request itself (waitForNetwork(), sendSMS()
+  // and, where the client has a background one, connect()).
+  template <class Fn>
+  TinyGsmDeferred<Modem, Fn> call(Fn fn) {
+    return TinyGsmDeferred<Modem, Fn>(_modem, fn);
+  }
+
+  auto waitForNetwork(uint32_t timeout_ms = 60000L) {
+    return request([this, timeout_ms](TinyGsmRequest& req) {
+      return _modem.waitForNetwork(req, timeout_ms);
+    });
+  }
+
+  auto gprsConnect(const char* apn, const char* user = NULL,
+                   const char* pwd = NULL) {
+    return call([this, apn, user, pwd]() {
+      return _modem.gprsConnect(apn, user, pwd);
+    });
+  }
+
+  // number and text have to outlive the co_await
+  auto sendSMS(const char* number, const char* text) {
+    return request([this, number, text](TinyGsmRequest& req) {
+      return _modem.sendSMS(req, number, text);
+    });
+  }
+
+  // host has to outlive the co_await
+  template <class Client>
+  auto connect(Client& client, const char* host, uint16_t port,
+               int timeout_s = 75) {
+    if constexpr (requires(TinyGsmRequest& req) {
+                    client.connect(req, host, port, timeout_s);
+                  }) {
+      return request([&client, host, port, timeout_s](TinyGsmRequest& req) {
+        return client.connect(req, host, port, timeout_s);
+      });
+    } else {
+      return call([&client, host, port, timeout_s]() {
+        return client.connect(host, port, timeout_s) != 0;
+      });
+    }
+  }
+
+  template <class Client>
+  auto write(Client& client, const uint8_t* buf, size_t len) {
+    return call([&client, buf, len]() { return client.write(buf, len); });
+  }
+
+  template <class Client>
+  TinyGsmReadAwaiter<Client> read(Client& client, uint8_t* buf, size_t len,
+                                  uint32_t timeout_ms = 1000L) {
+    return TinyGsmReadAwaiter<Client>(client, buf, len, timeout_ms);
+  }
+
+ private:
+  template <class Start>
+  TinyGsmRequestAwaiter<Start> request(Start start) {
+    return TinyGsmRequestAwaiter<Start>(start);
+  }
+
+  Modem&              _modem;
+  uint32_t            _maintain_ms;
+  uint32_t            _maintained;
+  bool                _pending = false;  // the modem has requests queued
+  TinyGsmTask::Handle _tasks[TINY_GSM_CORO_TASKS];
+};
+
+#endif  // SRC_TINYGSMCOROUTINE_H_
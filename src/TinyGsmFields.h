@@ -0,0 +1,167 @@
+/**
+ * @file       TinyGsmFields.h
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Oct 2026
+ */
+
+#ifndef SRC_TINYGSMFIELDS_H_
+#define SRC_TINYGSMFIELDS_H_
+
+#include "TinyGsmCommon.h"
+
+// Longest response line kept, and most fields split out of it.  Characters
+// past the end are dropped; separators past the last field are kept in it.
+#ifndef TINY_GSM_FIELDS_LINE
+#define TINY_GSM_FIELDS_LINE 128
+#endif
+
+#ifndef TINY_GSM_FIELDS_MAX
+#define TINY_GSM_FIELDS_MAX 24
+#endif
+
+// One response line split into its comma separated fields.
+//
+// The line is fed one character at a time (see streamGetFields() in
+// TinyGsmModem.tpp) and split as it arrives: leading spaces and quotes are
+// dropped and commas inside quotes are kept.  Nothing is allocated; the line
+// lives in the object, usually on the caller's stack.  Missing or empty
+// fields read as the given default.
+class TinyGsmFields {
+  static_assert(TINY_GSM_FIELDS_LINE > 1 && TINY_GSM_FIELDS_LINE <= 255,
+                "TINY_GSM_FIELDS_LINE must be within 2..255");
+
+ public:
+  TinyGsmFields() {
+    clear();
+  }
+
+  void clear() {
+    _len    = 0;
+    _count  = 0;
+    _quoted = false;
+    _start  = true;
+  }
+
+  // Adds one character; returns true once the line is complete
+  bool put(char c) {
+    if (c == '\n') {
+      end();
+      return true;
+    }
+    if (c == '\r') { return false; }
+    if (_start) {
+      if (c == ' ') { return false; }
+      if (_count < TINY_GSM_FIELDS_MAX) { _field[_count++] = _len; }
+      _start = false;
+    }
+    if (c == '"') {
+      _quoted = !_quoted;
+    } else if (c == ',' && !_quoted && _count < TINY_GSM_FIELDS_MAX) {
+      append('\0');
+      _start = true;
+    } else {
+      append(c);
+    }
+    return false;
+  }
+
+  // Terminates the last field; put('\n') does this
+  void end() {
+    // A trailing comma leaves an empty field after it
+    if (_start && _count && _count < TINY_GSM_FIELDS_MAX) {
+      _field[_count++] = _len;
+    }
+    _start     = false;
+    _buf[_len] = '\0';
+  }
+
+  uint8_t count() const {
+    return _count;
+  }
+
+  // Whether field i is there and not empty
+  bool has(uint8_t i) const {
+    return i < _count && _buf[_field[i]];
+  }
+
+  // Field i without its quotes, or "" when missing
+  const char* str(uint8_t i) const {
+    return i < _count ? &_buf[_field[i]] : "";
+  }
+
+  int32_t toInt(uint8_t i, int32_t def = -9999) const {
+    const char* s = str(i);
+    return *s ? atol(s) : def;
+  }
+
+  float toFloat(uint8_t i, float def = -9999.0F) const {
+    const char* s = str(i);
+    return *s ? atof(s) : def;
+  }
+
+  // Decimal field i as an integer number of 10^-decimals units, rounded down,
+  // e.g. "3.95" with 3 decimals is 3950, without going through a float
+  int32_t toFixed(uint8_t i, uint8_t decimals, int32_t def = -9999) const {
+    const char* s = str(i);
+    if (!*s) { return def; }
+    bool neg = *s == '-';
+    if (neg || *s == '+') { s++; }
+    int32_t res = 0;
+    for (; *s >= '0' && *s <= '9'; s++) { res = res * 10 + (*s - '0'); }
+    if (*s == '.') { s++; }
+    for (; decimals; decimals--) {
+      res *= 10;
+      if (*s >= '0' && *s <= '9') { res += *s++ - '0'; }
+    }
+    return neg ? -res : res;
+  }
+
+  // The up to len digits at offset pos of field i, for values packed into
+  // one field at fixed places, e.g. the month in "20190101120000.000"
+  int16_t digits(uint8_t i, uint8_t pos, uint8_t len,
+                 int16_t def = -9999) const {
+    const char* s = str(i);
+    for (uint8_t k = 0; k < pos; k++) {
+      if (!s[k]) { return def; }
+    }
+    s += pos;
+    if (*s < '0' || *s > '9') { return def; }
+    int16_t res = 0;
+    for (; len && *s >= '0' && *s <= '9'; len--, s++) {
+      res = res * 10 + (*s - '0');
+    }
+    return res;
+  }
+
+  // The n-th number within field i, for values set apart by other characters,
+  // e.g. the minute in "19/01/01,12:34:56+08" is number(0, 4).  A minus sign
+  // right before the digits is kept.
+  int16_t number(uint8_t i, uint8_t n, int16_t def = -9999) const {
+    const char* s = str(i);
+    while (*s) {
+      if (*s < '0' || *s > '9') {
+        s++;
+        continue;
+      }
+      if (!n--) { return (s > str(i) && s[-1] == '-') ? -atoi(s) : atoi(s); }
+      while (*s >= '0' && *s <= '9') { s++; }
+    }
+    return def;
+  }
+
+ private:
+  void append(char c) {
+    if (_len < TINY_GSM_FIELDS_LINE - 1) { _buf[_len++] = c; }
+  }
+
+  char    _buf[TINY_GSM_FIELDS_LINE];
+  uint8_t _field[TINY_GSM_FIELDS_MAX];  // start of each field in _buf
+  uint8_t _len;
+  uint8_t _count;
+  bool    _quoted;
+  bool    _start;  // the next character starts a field
+};
+
+#endif  // SRC_TINYGSMFIELDS_H_
@@ -7,9 +7,24 @@ class TinyGsmFifo
 public:
     TinyGsmFifo()
     {
+        attach(NULL, 0);
+    }
+
+    // Switches to a buffer of n elements owned by the caller, or back to the
+    // built-in one of N elements when buf is NULL.  Drops any content.
+    void attach(T* buf, int n)
+    {
+        bool own = buf && n > 1;
+        _p = own ? buf : _b;
+        _n = own ? n : N;
         clear();
     }
 
+    int capacity(void)
+    {
+        return _n - 1;
+    }
+
     void clear()
     {
         _r = 0;
@@ -28,7 +43,7 @@ public:
     {
         int s = _r - _w;
         if (s <= 0)
-            s += N;
+            s += _n;
         return s - 1;
     }
 
@@ -39,7 +54,7 @@ public:
         i = _inc(i);
         if (i == _r) // !writeable()
             return false;
-        _b[j] = c;
+        _p[j] = c;
         _w = i;
         return true;
     }
@@ -58,10 +73,10 @@ public:
             // check free space
             if (c < f) f = c;
             int w = _w;
-            int m = N - w;
+            int m = _n - w;
             // check wrap
             if (f > m) f = m;
-            memcpy(&_b[w], p, f);
+            memcpy(&_p[w], p, f);
             _w = _inc(w, f);
             c -= f;
             p += f;
@@ -69,6 +84,26 @@ public:
         return n - c;
     }
 
+    // Free space as two contiguous spans: from the write position up to the
+    // end of the buffer, then the part wrapped around to its start.  Fill the
+    // first one before the second and commit() the number written.
+    int writeSpans(T** s1, int* n1, T** s2, int* n2)
+    {
+        int f = free();
+        int w = _w;
+        int m = _n - w;
+        *s1 = &_p[w];
+        *n1 = f < m ? f : m;
+        *s2 = &_p[0];
+        *n2 = f - *n1;
+        return f;
+    }
+
+    void commit(int n)
+    {
+        _w = _inc(_w, n);
+    }
+
     // reading thread/context API
     // --------------------------------------------------------
 
@@ -81,7 +116,7 @@ public:
     {
         int s = _w - _r;
         if (s < 0)
-            s += N;
+            s += _n;
         return s;
     }
 
@@ -90,7 +125,7 @@ public:
         int r = _r;
         if (r == _w) // !readable()
             return false;
-        *p = _b[r];
+        *p = _p[r];
         _r = _inc(r);
         return true;
     }
@@ -111,10 +146,10 @@ public:
             // check available data
             if (c < f) f = c;
             int r = _r;
-            int m = N - r;
+            int m = _n - r;
             // check wrap
             if (f > m) f = m;
-            memcpy(p, &_b[r], f);
+            memcpy(p, &_p[r], f);
             _r = _inc(r, f);
             c -= f;
             p += f;
@@ -125,12 +160,206 @@ public:
 private:
     int _inc(int i, int n = 1)
     {
-        return (i + n) % N;
+        return (i + n) % _n;
     }
 
     T    _b[N];
+    T*   _p;
+    int  _n;
     int  _w;
     int  _r;
 };
 
+#if defined(TINY_GSM_RX_SPSC) || defined(TINY_GSM_THREADED)
+#include <atomic>
+
+// What a blocking put()/get() of TinyGsmSpscFifo does while it cannot make
+// progress: wait() gives the CPU away, notify() is called by the other side
+// after every change.  Each FIFO has a waiter of its own for either side
+// (for data, and for space), so one can hold a semaphore or condition
+// variable.  This one hands over to other tasks with yield().
+struct TinyGsmFifoYield
+{
+    void wait(void)
+    {
+        yield();
+    }
+    void notify(void) {}
+};
+
+// Single-producer/single-consumer variant of TinyGsmFifo with the same API,
+// for when one side runs in an ISR or another thread (e.g. a UART reader
+// filling socket buffers while the application drains them).
+//
+// The indices run freely and are masked with the power-of-two capacity, so
+// all N elements are usable.  Each index is written by one side only, with
+// release ordering, and read by the other with acquire ordering; no locks are
+// taken.  clear() and attach() must only be called while both sides are idle.
+template <class T, unsigned N, class Waiter = TinyGsmFifoYield>
+class TinyGsmSpscFifo
+{
+    static_assert(N && !(N & (N - 1)),
+                  "TinyGsmSpscFifo size must be a power of two");
+
+public:
+    TinyGsmSpscFifo() : _w(0), _r(0)
+    {
+        attach(NULL, 0);
+    }
+
+    // Switches to a buffer of n elements owned by the caller, rounded down to
+    // a power of two, or back to the built-in one when buf is NULL
+    void attach(T* buf, int n)
+    {
+        unsigned m = 1;
+        while (buf && m * 2 <= static_cast<unsigned>(n)) m *= 2;
+        bool own = buf && m > 1;
+        _p = own ? buf : _b;
+        _mask = (own ? m : N) - 1;
+        clear();
+    }
+
+    void clear()
+    {
+        _r.store(_w.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    int capacity(void)
+    {
+        return _mask + 1;
+    }
+
+    // writing thread/context API
+    //-------------------------------------------------------------
+
+    bool writeable(void)
+    {
+        return free() > 0;
+    }
+
+    int free(void)
+    {
+        unsigned w = _w.load(std::memory_order_relaxed);
+        return _mask + 1 - (w - _r.load(std::memory_order_acquire));
+    }
+
+    bool put(const T& c)
+    {
+        unsigned w = _w.load(std::memory_order_relaxed);
+        if (w - _r.load(std::memory_order_acquire) > _mask) // !writeable()
+            return false;
+        _p[w & _mask] = c;
+        _w.store(w + 1, std::memory_order_release);
+        _data.notify();
+        return true;
+    }
+
+    int put(const T* p, int n, bool t = false)
+    {
+        int c = n;
+        while (c)
+        {
+            T* s1;
+            T* s2;
+            int n1;
+            int n2;
+            while (writeSpans(&s1, &n1, &s2, &n2) == 0) // wait for space
+            {
+                if (!t) return n - c; // no more space and not blocking
+                _space.wait();
+            }
+            int f = c < n1 ? c : n1;
+            memcpy(s1, p, f * sizeof(T));
+            commit(f);
+            c -= f;
+            p += f;
+        }
+        return n - c;
+    }
+
+    // Free space as two contiguous spans: from the write position up to the
+    // end of the buffer, then the part wrapped around to its start.  Fill the
+    // first one before the second and commit() the number written.
+    int writeSpans(T** s1, int* n1, T** s2, int* n2)
+    {
+        unsigned w = _w.load(std::memory_order_relaxed);
+        int f = _mask + 1 - (w - _r.load(std::memory_order_acquire));
+        int m = _mask + 1 - (w & _mask);
+        *s1 = &_p[w & _mask];
+        *n1 = f < m ? f : m;
+        *s2 = &_p[0];
+        *n2 = f - *n1;
+        return f;
+    }
+
+    void commit(int n)
+    {
+        _w.store(_w.load(std::memory_order_relaxed) + n,
+                 std::memory_order_release);
+        _data.notify();
+    }
+
+    // reading thread/context API
+    // --------------------------------------------------------
+
+    bool readable(void)
+    {
+        return size() > 0;
+    }
+
+    size_t size(void)
+    {
+        unsigned r = _r.load(std::memory_order_relaxed);
+        return _w.load(std::memory_order_acquire) - r;
+    }
+
+    bool get(T* p)
+    {
+        unsigned r = _r.load(std::memory_order_relaxed);
+        if (r == _w.load(std::memory_order_acquire)) // !readable()
+            return false;
+        *p = _p[r & _mask];
+        _r.store(r + 1, std::memory_order_release);
+        _space.notify();
+        return true;
+    }
+
+    int get(T* p, int n, bool t = false)
+    {
+        int c = n;
+        while (c)
+        {
+            unsigned r = _r.load(std::memory_order_relaxed);
+            int f;
+            // wait for data
+            while ((f = _w.load(std::memory_order_acquire) - r) == 0)
+            {
+                if (!t) return n - c; // no data and not blocking
+                _data.wait();
+            }
+            // check available data
+            if (c < f) f = c;
+            int m = _mask + 1 - (r & _mask);
+            // check wrap
+            if (f > m) f = m;
+            memcpy(p, &_p[r & _mask], f * sizeof(T));
+            _r.store(r + f, std::memory_order_release);
+            _space.notify();
+            c -= f;
+            p += f;
+        }
+        return n - c;
+    }
+
+private:
+    T                     _b[N];
+    T*                    _p;
+    unsigned              _mask;
+    std::atomic<unsigned> _w;
+    std::atomic<unsigned> _r;
+    Waiter                _data;   // the reader waits here for data
+    Waiter                _space;  // the writer waits here for space
+};
+#endif
+
 #endif
@@ -10,6 +10,7 @@
 #define SRC_TINYGSMGPRS_H_
 
 #include "TinyGsmCommon.h"
+#include "TinyGsmThread.h"
 
 #define TINY_GSM_MODEM_HAS_GPRS
 
@@ -28,21 +29,26 @@ class TinyGsmGPRS {
    */
   // Unlocks the SIM
   bool simUnlock(const char* pin) {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().simUnlockImpl(pin);
   }
   // Gets the CCID of a sim card via AT+CCID
   String getSimCCID() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getSimCCIDImpl();
   }
   // Asks for TA Serial Number Identification (IMEI)
   String getIMEI() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getIMEIImpl();
   }
   // Asks for International Mobile Subscriber Identity IMSI
   String getIMSI() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getIMSIImpl();
   }
   SimStatus getSimStatus(uint32_t timeout_ms = 10000L) {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getSimStatusImpl(timeout_ms);
   }
 
@@ -51,17 +57,31 @@ class TinyGsmGPRS {
    */
   bool gprsConnect(const char* apn, const char* user = NULL,
                    const char* pwd = NULL) {
-    return thisModem().gprsConnectImpl(apn, user, pwd);
+    TINY_GSM_MODEM_LOCK();
+    bool res = thisModem().gprsConnectImpl(apn, user, pwd);
+    thisModem().forgetBearer();
+    return res;
   }
   bool gprsDisconnect() {
-    return thisModem().gprsDisconnectImpl();
+    TINY_GSM_MODEM_LOCK();
+    bool res = thisModem().gprsDisconnectImpl();
+    thisModem().forgetBearer();
+    return res;
   }
-  // Checks if current attached to GPRS/EPS service
+  // Checks if current attached to GPRS/EPS service.  The answer is kept until
+  // gprsConnect(), gprsDisconnect() or a bearer event or registration change
+  // reported by the modem, so asking again costs nothing meanwhile.
   bool isGprsConnected() {
-    return thisModem().isGprsConnectedImpl();
+    TINY_GSM_MODEM_LOCK();
+    int8_t known = thisModem().knownBearer();
+    if (known >= 0) { return known; }
+    bool res = thisModem().isGprsConnectedImpl();
+    thisModem().storeBearer(res);
+    return res;
   }
   // Gets the current network operator
   String getOperator() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getOperatorImpl();
   }
 
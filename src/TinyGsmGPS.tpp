@@ -10,6 +10,7 @@
 #define SRC_TINYGSMGPS_H_
 
 #include "TinyGsmCommon.h"
+#include "TinyGsmThread.h"
 
 #define TINY_GSM_MODEM_HAS_GPS
 
@@ -20,23 +21,28 @@ class TinyGsmGPS {
    * GPS/GNSS/GLONASS location functions
    */
   bool enableGPS() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().enableGPSImpl();
   }
   bool disableGPS() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().disableGPSImpl();
   }
   String getGPSraw() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getGPSrawImpl();
   }
   bool getGPS(float* lat, float* lon, float* speed = 0, float* alt = 0,
               int* vsat = 0, int* usat = 0, float* accuracy = 0, int* year = 0,
               int* month = 0, int* day = 0, int* hour = 0, int* minute = 0,
               int* second = 0) {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getGPSImpl(lat, lon, speed, alt, vsat, usat, accuracy,
                                   year, month, day, hour, minute, second);
   }
   bool getGPSTime(int* year, int* month, int* day, int* hour, int* minute,
                   int* second) {
+    TINY_GSM_MODEM_LOCK();
     float lat = 0;
     float lon = 0;
     return thisModem().getGPSImpl(&lat, &lon, 0, 0, 0, 0, 0, year, month, day,
@@ -44,10 +50,12 @@ class TinyGsmGPS {
   }
 
   String setGNSSMode(uint8_t mode, bool dpo) {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().setGNSSModeImpl(mode, dpo);
   }
 
   uint8_t getGNSSMode() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getGNSSModeImpl();
   }
 
@@ -10,6 +10,8 @@
 #define SRC_TINYGSMGSMLOCATION_H_
 
 #include "TinyGsmCommon.h"
+#include "TinyGsmFields.h"
+#include "TinyGsmThread.h"
 
 #define TINY_GSM_MODEM_HAS_GSM_LOCATION
 
@@ -20,16 +22,19 @@ class TinyGsmGSMLocation {
    * GSM Location functions
    */
   String getGsmLocationRaw() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getGsmLocationRawImpl();
   }
 
   String getGsmLocation() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getGsmLocationRawImpl();
   }
 
   bool getGsmLocation(float* lat, float* lon, float* accuracy = 0,
                       int* year = 0, int* month = 0, int* day = 0,
                       int* hour = 0, int* minute = 0, int* second = 0) {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getGsmLocationImpl(lat, lon, accuracy, year, month, day,
                                           hour, minute, second);
   };
@@ -98,35 +103,25 @@ class TinyGsmGSMLocation {
     thisModem().sendAT(GF("+CLBS=4,1"));
     // Should get a location code of "0" indicating success
     if (thisModem().waitResponse(120000L, GF("+CLBS: ")) != 1) { return false; }
-    int8_t locationCode = thisModem().streamGetIntLength(2);
+    TinyGsmFields fields;
+    thisModem().streamGetFields(fields);
     // 0 = success, else, error
-    if (locationCode != 0) {
+    if (fields.toInt(0) != 0) {
       thisModem().waitResponse();  // should be an ok after the error
       return false;
     }
 
-    // init variables
-    float ilat      = 0;
-    float ilon      = 0;
-    float iaccuracy = 0;
-    int   iyear     = 0;
-    int   imonth    = 0;
-    int   iday      = 0;
-    int   ihour     = 0;
-    int   imin      = 0;
-    int   isec      = 0;
-
-    ilat      = thisModem().streamGetFloatBefore(',');  // Latitude
-    ilon      = thisModem().streamGetFloatBefore(',');  // Longitude
-    iaccuracy = thisModem().streamGetIntBefore(',');    // Positioning accuracy
+    float ilat      = fields.toFloat(1);  // Latitude
+    float ilon      = fields.toFloat(2);  // Longitude
+    float iaccuracy = fields.toInt(3);    // Positioning accuracy
 
     // Date & Time
-    iyear  = thisModem().streamGetIntBefore('/');
-    imonth = thisModem().streamGetIntBefore('/');
-    iday   = thisModem().streamGetIntBefore(',');
-    ihour  = thisModem().streamGetIntBefore(':');
-    imin   = thisModem().streamGetIntBefore(':');
-    isec   = thisModem().streamGetIntBefore('\n');
+    int iyear  = fields.number(4, 0, 0);
+    int imonth = fields.number(4, 1, 0);
+    int iday   = fields.number(4, 2, 0);
+    int ihour  = fields.number(5, 0, 0);
+    int imin   = fields.number(5, 1, 0);
+    int isec   = fields.number(5, 2, 0);
 
     // Set pointers
     if (lat != NULL) *lat = ilat;
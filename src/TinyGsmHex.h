@@ -0,0 +1,60 @@
+/**
+ * @file       TinyGsmHex.h
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Oct 2026
+ */
+
+#ifndef SRC_TINYGSMHEX_H_
+#define SRC_TINYGSMHEX_H_
+
+#include "TinyGsmCommon.h"
+
+// Value of one hex digit, either case.  Other characters give garbage rather
+// than an error, the same as the modem sending garbage would.
+inline uint8_t TinyGsmHexNibble(uint8_t c) {
+  return (c & 0x0F) + 9 * (c >> 6);
+}
+
+// Decodes the 2 * n hex digits at src into n bytes at dst, without branching
+// on the data.  On 32 and 64 bit targets a whole word of digits is decoded at
+// once (SWAR).  dst may be the same buffer as src.  Returns n.
+inline size_t TinyGsmHexDecode(uint8_t* dst, const char* src, size_t n) {
+  const uint8_t* s = reinterpret_cast<const uint8_t*>(src);
+  size_t         i = 0;
+#if UINTPTR_MAX > 0xFFFFFFFF
+  typedef uint64_t Word;
+#elif UINTPTR_MAX > 0xFFFF
+  typedef uint32_t Word;
+#endif
+#if UINTPTR_MAX > 0xFFFF
+  const Word ones = ~static_cast<Word>(0) / 0xFF;    // 0x0101...
+  const Word nibs = ones * 0x0F;                     // 0x0F0F...
+  const Word odds = ~static_cast<Word>(0) / 0xFFFF;  // 0x0001 0001...
+  for (; i + sizeof(Word) / 2 <= n; i += sizeof(Word) / 2) {
+    // The first digit goes to the lowest byte
+    Word x = 0;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    for (uint8_t k = 0; k < sizeof(Word); k++) {
+      x |= static_cast<Word>(s[2 * i + k]) << (8 * k);
+    }
+#else
+    memcpy(&x, s + 2 * i, sizeof(x));
+#endif
+    Word v = (x & nibs) + ((x >> 6) & ones) * 9;
+    // Each even byte takes its digit as the high nibble, the odd one after it
+    // as the low nibble
+    v = ((v << 4) | (v >> 8)) & (odds * 0xFF);
+    for (uint8_t k = 0; k < sizeof(Word) / 2; k++) {
+      dst[i + k] = static_cast<uint8_t>(v >> (16 * k));
+    }
+  }
+#endif
+  for (; i < n; i++) {
+    dst[i] = (TinyGsmHexNibble(s[2 * i]) << 4) | TinyGsmHexNibble(s[2 * i + 1]);
+  }
+  return n;
+}
+
+#endif  // SRC_TINYGSMHEX_H_
@@ -0,0 +1,413 @@
+/**
+ * @file       TinyGsmMatcher.h
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Oct 2026
+ */
+
+#ifndef SRC_TINYGSMMATCHER_H_
+#define SRC_TINYGSMMATCHER_H_
+
+#include "TinyGsmCommon.h"
+
+// Room for the longest URC prefix, terminator included
+#ifndef TINY_GSM_URC_PREFIX
+#define TINY_GSM_URC_PREFIX 16
+#endif
+
+// Look-behind kept while parsing; must be a power of two.  The URC handlers
+// look back at most across a line like "0, SEND FAIL", which 16 holds.
+#ifndef TINY_GSM_RESPONSE_RING
+#if defined(__AVR__)
+#define TINY_GSM_RESPONSE_RING 16
+#else
+#define TINY_GSM_RESPONSE_RING 32
+#endif
+#endif
+
+// Reads one character of a pattern, wherever GsmConstStr points
+inline char TinyGsmPatternChar(GsmConstStr s, size_t i) {
+#if defined(__AVR__) && !defined(__AVR_ATmega4809__)
+  return pgm_read_byte(reinterpret_cast<const char*>(s) + i);
+#else
+  return s[i];
+#endif
+}
+
+// Incremental matcher for the up to six responses a waitResponse() call
+// expects.  Each keeps the length of its longest prefix the input ends with,
+// advanced one character at a time as in KMP, with the fallback on a mismatch
+// worked out from the pattern itself: nothing is built per call, and the
+// state is one byte per response.
+class TinyGsmResponseMatcher {
+ public:
+  TinyGsmResponseMatcher() {
+    expect(NULL, NULL, NULL, NULL, NULL);
+  }
+
+  // Sets up r1..r6 as ids 1..6; NULL or empty ones never match
+  void expect(GsmConstStr r1, GsmConstStr r2, GsmConstStr r3, GsmConstStr r4,
+              GsmConstStr r5, GsmConstStr r6 = NULL) {
+    _expected[0] = r1;
+    _expected[1] = r2;
+    _expected[2] = r3;
+    _expected[3] = r4;
+    _expected[4] = r5;
+    _expected[5] = r6;
+    reset();
+  }
+
+  // Forgets any partial match
+  void reset() {
+    for (uint8_t i = 0; i < 6; i++) { _matched[i] = 0; }
+  }
+
+  // Returns the lowest id of the responses ending at c, or 0
+  uint8_t feed(char c) {
+    uint8_t id = 0;
+    for (uint8_t i = 0; i < 6; i++) {
+      GsmConstStr p = _expected[i];
+      if (!p) continue;
+      uint8_t q = advance(p, _matched[i], c);
+      if (q && !TinyGsmPatternChar(p, q)) {
+        if (!id) { id = i + 1; }
+        q = 0;
+      }
+      _matched[i] = q;
+    }
+    return id;
+  }
+
+ private:
+  // Length of the longest prefix of p the input ends with, once c follows
+  // the q characters of p already matched
+  static uint8_t advance(GsmConstStr p, uint8_t q, char c) {
+    if (TinyGsmPatternChar(p, q) == c) { return q + 1; }
+    for (uint8_t len = q; len > 0; len--) {
+      if (TinyGsmPatternChar(p, len - 1) != c) continue;
+      uint8_t k = 0;
+      while (k + 1 < len && TinyGsmPatternChar(p, k) ==
+                                TinyGsmPatternChar(p, q - len + 1 + k)) {
+        k++;
+      }
+      if (k + 1 == len) { return len; }
+    }
+    return 0;
+  }
+
+  GsmConstStr _expected[6];
+  uint8_t     _matched[6];
+};
+
+// A trie of URC prefixes (Aho-Corasick), worked out at compile time from a
+// driver's URC table and kept in flash.  Node 0 is the root; node ids follow
+// the table, each entry adding the nodes for the part of its prefix no entry
+// before it shares.  `out` is the lowest id (table index + 1) of the prefixes
+// ending at the node, also through its failure links.
+struct TinyGsmTrieNode {
+  char    c;        // the character leading to the node
+  uint8_t child;    // first child
+  uint8_t sibling;  // next child of the same parent
+  uint8_t fail;     // longest proper suffix that is a node too
+  uint8_t out;
+};
+
+// The constexpr functions below take a table ending with an empty prefix and
+// are evaluated by the compiler only.
+
+// Whether a and b agree on their first n characters
+constexpr bool TinyGsmSamePrefix(const char* a, const char* b, uint8_t n) {
+  return !n || (*a && *a == *b && TinyGsmSamePrefix(a + 1, b + 1, n - 1));
+}
+
+constexpr uint8_t TinyGsmPrefixLength(const char* s, uint8_t n = 0) {
+  return s[n] ? TinyGsmPrefixLength(s, n + 1) : n;
+}
+
+// Number of leading characters a and b have in common
+constexpr uint8_t TinyGsmCommonLength(const char* a, const char* b,
+                                      uint8_t n = 0) {
+  return a[n] && a[n] == b[n] ? TinyGsmCommonLength(a, b, n + 1) : n;
+}
+
+// Most leading characters entry i has in common with an entry before it:
+// the nodes it shares
+template <typename Entry>
+constexpr uint8_t TinyGsmTrieShared(const Entry* t, uint8_t i, uint8_t j = 0,
+                                    uint8_t best = 0) {
+  return j >= i ? best
+                : TinyGsmTrieShared(
+                      t, i, j + 1,
+                      TinyGsmCommonLength(t[j].prefix, t[i].prefix) > best
+                          ? TinyGsmCommonLength(t[j].prefix, t[i].prefix)
+                          : best);
+}
+
+// Nodes entry i adds
+template <typename Entry>
+constexpr uint8_t TinyGsmTrieAdded(const Entry* t, uint8_t i) {
+  return TinyGsmPrefixLength(t[i].prefix) > TinyGsmTrieShared(t, i)
+             ? TinyGsmPrefixLength(t[i].prefix) - TinyGsmTrieShared(t, i)
+             : 0;
+}
+
+// Nodes the entries before i add
+template <typename Entry>
+constexpr uint8_t TinyGsmTrieBase(const Entry* t, uint8_t i) {
+  return i ? TinyGsmTrieBase(t, i - 1) + TinyGsmTrieAdded(t, i - 1) : 0;
+}
+
+template <typename Entry>
+constexpr uint8_t TinyGsmTrieEntries(const Entry* t, uint8_t i = 0) {
+  return t[i].prefix[0] ? TinyGsmTrieEntries(t, i + 1) : i;
+}
+
+// Number of trie nodes, root included, that the prefixes of a table take up
+template <typename Entry>
+constexpr uint8_t TinyGsmTrieSize(const Entry* t) {
+  return 1 + TinyGsmTrieBase(t, TinyGsmTrieEntries(t));
+}
+
+// First entry, from j on, whose prefix starts with the n characters at s; the
+// terminator if none does
+template <typename Entry>
+constexpr uint8_t TinyGsmTrieFirst(const Entry* t, const char* s, uint8_t n,
+                                   uint8_t j = 0) {
+  return !t[j].prefix[0] || TinyGsmSamePrefix(t[j].prefix, s, n)
+             ? j
+             : TinyGsmTrieFirst(t, s, n, j + 1);
+}
+
+// Id of the node for the first n characters of entry i, the first entry with
+// that prefix
+template <typename Entry>
+constexpr uint8_t TinyGsmTrieId(const Entry* t, uint8_t i, uint8_t n) {
+  return n ? 1 + TinyGsmTrieBase(t, i) + n - 1 - TinyGsmTrieShared(t, i) : 0;
+}
+
+// Id of the node for the n characters at s, or 0 if there is none
+template <typename Entry>
+constexpr uint8_t TinyGsmTrieFind(const Entry* t, const char* s, uint8_t n) {
+  return t[TinyGsmTrieFirst(t, s, n)].prefix[0]
+             ? TinyGsmTrieId(t, TinyGsmTrieFirst(t, s, n), n)
+             : 0;
+}
+
+// Entry that added node id (not the root)
+template <typename Entry>
+constexpr uint8_t TinyGsmTrieOwner(const Entry* t, uint8_t id, uint8_t i = 0) {
+  return id - 1 < TinyGsmTrieBase(t, i + 1) ? i
+                                            : TinyGsmTrieOwner(t, id, i + 1);
+}
+
+// Length of the prefix that node id, added by entry i, stands for
+template <typename Entry>
+constexpr uint8_t TinyGsmTrieDepth(const Entry* t, uint8_t id, uint8_t i) {
+  return id - TinyGsmTrieBase(t, i) + TinyGsmTrieShared(t, i);
+}
+
+// First child of the node for the n characters at s: the node of the first
+// entry, from j on, that goes on past them
+template <typename Entry>
+constexpr uint8_t TinyGsmTrieChild(const Entry* t, const char* s, uint8_t n,
+                                   uint8_t j = 0) {
+  return !t[j].prefix[0] ? 0
+         : TinyGsmSamePrefix(t[j].prefix, s, n) && t[j].prefix[n]
+             ? TinyGsmTrieId(t, j, n + 1)
+             : TinyGsmTrieChild(t, s, n, j + 1);
+}
+
+// Next sibling of the node for the first n characters of entry i: the node
+// of the next entry that shares the parent and adds a node below it
+template <typename Entry>
+constexpr uint8_t TinyGsmTrieSibling(const Entry* t, uint8_t i, uint8_t n,
+                                     uint8_t j) {
+  return !t[j].prefix[0] ? 0
+         : TinyGsmSamePrefix(t[j].prefix, t[i].prefix, n - 1) &&
+                 t[j].prefix[n - 1] && TinyGsmTrieShared(t, j) < n
+             ? TinyGsmTrieId(t, j, n)
+             : TinyGsmTrieSibling(t, i, n, j + 1);
+}
+
+// Failure link of the node for the n characters at s: the node of their
+// longest suffix, from the one dropping `skip` characters on, that has one
+template <typename Entry>
+constexpr uint8_t TinyGsmTrieFail(const Entry* t, const char* s, uint8_t n,
+                                  uint8_t skip = 1) {
+  return skip >= n ? 0
+         : TinyGsmTrieFind(t, s + skip, n - skip)
+             ? TinyGsmTrieFind(t, s + skip, n - skip)
+             : TinyGsmTrieFail(t, s, n, skip + 1);
+}
+
+// Lowest id, from entry j on, of the prefixes the n characters at s end with
+template <typename Entry>
+constexpr uint8_t TinyGsmTrieOut(const Entry* t, const char* s, uint8_t n,
+                                 uint8_t j = 0) {
+  return !t[j].prefix[0] ? 0
+         : TinyGsmPrefixLength(t[j].prefix) <= n &&
+                 TinyGsmSamePrefix(t[j].prefix,
+                                   s + n - TinyGsmPrefixLength(t[j].prefix),
+                                   TinyGsmPrefixLength(t[j].prefix))
+             ? j + 1
+             : TinyGsmTrieOut(t, s, n, j + 1);
+}
+
+template <typename Entry>
+constexpr TinyGsmTrieNode TinyGsmTrieNodeOf(const Entry* t, uint8_t i,
+                                            uint8_t n) {
+  return {t[i].prefix[n - 1], TinyGsmTrieChild(t, t[i].prefix, n),
+          TinyGsmTrieSibling(t, i, n, i + 1),
+          TinyGsmTrieFail(t, t[i].prefix, n),
+          TinyGsmTrieOut(t, t[i].prefix, n)};
+}
+
+template <typename Entry>
+constexpr TinyGsmTrieNode TinyGsmTrieNodeAt(const Entry* t, uint8_t id) {
+  return id ? TinyGsmTrieNodeOf(
+                   t, TinyGsmTrieOwner(t, id),
+                   TinyGsmTrieDepth(t, id, TinyGsmTrieOwner(t, id)))
+            : TinyGsmTrieNode{0, TinyGsmTrieChild(t, t[0].prefix, 0), 0, 0, 0};
+}
+
+template <uint8_t... Ids>
+struct TinyGsmTrieIds {};
+template <uint8_t N, uint8_t... Ids>
+struct TinyGsmTrieMakeIds : TinyGsmTrieMakeIds<N - 1, N - 1, Ids...> {};
+template <uint8_t... Ids>
+struct TinyGsmTrieMakeIds<0, Ids...> {
+  typedef TinyGsmTrieIds<Ids...> type;
+};
+
+// The N nodes of a trie, N being TinyGsmTrieSize() of the table:
+//
+//   typedef TinyGsmTrie<TinyGsmTrieSize(urcs)> Trie;
+//   static constexpr Trie trie TINY_GSM_PROGMEM = Trie::of(urcs);
+template <uint8_t N>
+struct TinyGsmTrie {
+  TinyGsmTrieNode nodes[N];
+
+  template <typename Entry>
+  static constexpr TinyGsmTrie of(const Entry* t) {
+    return of(t, typename TinyGsmTrieMakeIds<N>::type());
+  }
+
+  template <typename Entry, uint8_t... Ids>
+  static constexpr TinyGsmTrie of(const Entry* t, TinyGsmTrieIds<Ids...>) {
+    return {{TinyGsmTrieNodeAt(t, Ids)...}};
+  }
+};
+
+// Runs a trie in flash over the input: the object keeps nothing but the state
+class TinyGsmTrieMatcher {
+ public:
+  TinyGsmTrieMatcher() : _state(0) {}
+
+  // Forgets any partial match
+  void reset() {
+    _state = 0;
+  }
+
+  // Returns the lowest id of the prefixes ending at c, or 0
+  uint8_t feed(const TinyGsmTrieNode* nodes, char c) {
+    uint8_t s = _state;
+    uint8_t t;
+    while (!(t = child(nodes, s, c)) && s) { s = node(nodes, s).fail; }
+    _state = t;
+    return t ? node(nodes, t).out : 0;
+  }
+
+ private:
+  static TinyGsmTrieNode node(const TinyGsmTrieNode* nodes, uint8_t id) {
+#if defined(__AVR__) && !defined(__AVR_ATmega4809__)
+    TinyGsmTrieNode n;
+    memcpy_P(&n, &nodes[id], sizeof(n));
+    return n;
+#else
+    return nodes[id];
+#endif
+  }
+
+  static uint8_t child(const TinyGsmTrieNode* nodes, uint8_t id, char c) {
+    uint8_t n = node(nodes, id).child;
+    while (n) {
+      TinyGsmTrieNode x = node(nodes, n);
+      if (x.c == c) break;
+      n = x.sibling;
+    }
+    return n;
+  }
+
+  uint8_t _state;
+};
+
+// The last N characters of a response, for URCs that need to look back at
+// what preceded the part that matched (e.g. the mux in "0, CLOSED")
+template <uint8_t N>
+class TinyGsmRing {
+ public:
+  TinyGsmRing() {
+    clear();
+  }
+
+  void clear() {
+    _head = 0;
+    _fill = 0;
+  }
+
+  void put(char c) {
+    _buf[_head] = c;
+    _head       = (_head + 1) & (N - 1);
+    if (_fill < N) { _fill++; }
+  }
+
+  uint8_t size() const {
+    return _fill;
+  }
+
+  // Whether it holds nothing but spaces and line ends
+  bool blank() const {
+    for (uint8_t i = 0; i < _fill; i++) {
+      char c = (*this)[i];
+      if (c != ' ' && c != '\r' && c != '\n') { return false; }
+    }
+    return true;
+  }
+
+  // Character `back` places before the newest one
+  char operator[](uint8_t back) const {
+    return _buf[(_head - 1 - back) & (N - 1)];
+  }
+
+  // Integer at the start of the line holding the character `back` places
+  // before the newest one, or -1 when it scrolled out of the ring
+  int16_t lineInt(uint8_t back) const {
+    if (back >= size()) { return -1; }
+    uint8_t i = back;
+    while (i + 1 < size() && (*this)[i + 1] != '\n') { i++; }
+    if (i + 1 >= size() && _fill == N) { return -1; }
+    int16_t res = -1;
+    for (;; i--) {
+      char c = (*this)[i];
+      if (c < '0' || c > '9') break;
+      res = (res < 0 ? 0 : res * 10) + (c - '0');
+      if (!i) break;
+    }
+    return res;
+  }
+
+  String toString() const {
+    String s;
+    s.reserve(size());
+    for (uint8_t i = size(); i > 0; i--) { s += (*this)[i - 1]; }
+    return s;
+  }
+
+ private:
+  char    _buf[N];
+  uint8_t _head;
+  uint8_t _fill;
+};
+
+#endif  // SRC_TINYGSMMATCHER_H_
@@ -10,6 +10,121 @@
 #define SRC_TINYGSMMODEM_H_
 
 #include "TinyGsmCommon.h"
+#include "TinyGsmFields.h"
+#include "TinyGsmMatcher.h"
+#include "TinyGsmRequest.h"
+#include "TinyGsmSignal.h"
+#include "TinyGsmThread.h"
+
+// Stack buffer sendAT() renders a command into, to hand it to the stream in
+// one write(); longer commands go out in several
+#ifndef TINY_GSM_AT_BUFFER
+#define TINY_GSM_AT_BUFFER 64
+#endif
+
+// Commands a Batch leaves unanswered at most: TINY_GSM_AT_WINDOW bytes of
+// them, and no more than the driver's atPipelineImpl(), itself capped at
+// TINY_GSM_AT_PIPELINE.  The window has to fit in the modem's command input
+// buffer; 0 sends one command at a time.
+#ifndef TINY_GSM_AT_WINDOW
+#define TINY_GSM_AT_WINDOW 128
+#endif
+
+#ifndef TINY_GSM_AT_PIPELINE
+#define TINY_GSM_AT_PIPELINE 8
+#endif
+
+// How long the registration and bearer state the modem reports by itself are
+// trusted before it is asked again, in case a report went missing
+#ifndef TINY_GSM_REG_RESYNC
+#define TINY_GSM_REG_RESYNC 300000L
+#endif
+
+// A Print that takes several arguments in one add()
+class TinyGsmPrinter : public Print {
+ public:
+  using Print::write;
+
+  // Prints each argument in turn
+  void add() {}
+  template <typename T, typename... Args>
+  void add(T&& head, Args&&... tail) {
+    addOne(head);
+    add(tail...);
+  }
+
+ private:
+  // The length of a literal is known at compile time.  Other const arrays are
+  // measured unless their last character is in use.
+  template <size_t M>
+  void addOne(const char (&s)[M]) {
+    write(s, M > 1 && s[M - 2] ? M - 1 : strlen(s));
+  }
+  template <size_t M>
+  void addOne(char (&s)[M]) {
+    print(s);
+  }
+  template <typename T>
+  void addOne(const T& value) {
+    print(value);
+  }
+};
+
+// Collects what is printed to it and passes it on to a stream in as few
+// write() calls as N bytes allow
+template <size_t N>
+class TinyGsmPrintBuffer : public TinyGsmPrinter {
+ public:
+  explicit TinyGsmPrintBuffer(Stream& stream) : _stream(stream), _len(0) {}
+
+  size_t write(uint8_t c) override {
+    if (_len == N) { send(); }
+    _buf[_len++] = c;
+    return 1;
+  }
+
+  size_t write(const uint8_t* p, size_t n) override {
+    for (size_t left = n; left;) {
+      if (_len == N) { send(); }
+      size_t k = TinyGsmMin(left, N - _len);
+      memcpy(_buf + _len, p, k);
+      _len += k;
+      p += k;
+      left -= k;
+    }
+    return n;
+  }
+  using TinyGsmPrinter::write;
+
+  // Writes out what has been collected
+  void send() {
+    if (_len) { _stream.write(_buf, _len); }
+    _len = 0;
+  }
+
+ private:
+  Stream& _stream;
+  uint8_t _buf[N];
+  size_t  _len;
+};
+
+// Counts what is printed to it
+class TinyGsmPrintCounter : public TinyGsmPrinter {
+ public:
+  TinyGsmPrintCounter() : count(0) {}
+
+  size_t write(uint8_t) override {
+    count++;
+    return 1;
+  }
+  size_t write(const uint8_t*, size_t n) override {
+    count += n;
+    return n;
+  }
+  using TinyGsmPrinter::write;
+
+  size_t count;
+};
 
 template <class modemType>
 class TinyGsmModem {
@@ -18,35 +133,183 @@ class TinyGsmModem {
    * Basic functions
    */
   bool begin(const char* pin = NULL) {
+    TINY_GSM_MODEM_LOCK();
+    forgetNetwork();
     return thisModem().initImpl(pin);
   }
   bool init(const char* pin = NULL) {
+    TINY_GSM_MODEM_LOCK();
+    forgetNetwork();
     return thisModem().initImpl(pin);
   }
+  // Renders the command on the stack and writes it out in one piece.  There
+  // is no flush(): the response is waited for anyway.
   template <typename... Args>
-  inline void sendAT(Args... cmd) {
-    thisModem().streamWrite("AT", cmd..., thisModem().gsmNL);
-    thisModem().stream.flush(); 
-    TINY_GSM_YIELD(); DBG("### AT:", cmd...); 
+  inline void sendAT(Args&&... cmd) {
+    settleRequest();
+    if (thisModem().inDataModeImpl()) {
+      thisModem().leaveDataModeImpl();
+      // Still in data mode: the command would go out on the connection
+      if (thisModem().inDataModeImpl()) { return; }
+    }
+    if (!batched) { thisModem().beforeCommandImpl(); }
+    TinyGsmPrintBuffer<TINY_GSM_AT_BUFFER> buf(thisModem().stream);
+    buf.add("AT", cmd..., thisModem().gsmNL);
+    buf.send();
+    TINY_GSM_YIELD();
+    DBG("### AT:", cmd...);
   }
+
+  // Commands sent back to back instead of one per round trip:
+  //
+  //   TinyGsm::Batch batch(modem);
+  //   batch.add(GF("+CGDCONT=1,\"IP\",\""), apn, '"');
+  //   batch.add(GF("+CGATT=1")).timeout(60000L).wait();
+  //   batch.add(GF("+CGPADDR=1")).expect(GF("+CGPADDR:"));
+  //   if (!batch.done()) { ... }
+  //
+  // add() writes its command out right away, unless that would leave more
+  // than TINY_GSM_AT_WINDOW bytes of commands unanswered; then it first reads
+  // the answers to the oldest ones.  Answers are matched in order.  Once a
+  // command has failed nothing more is sent, but the answers to the commands
+  // already on their way are still read out.
+  class Batch {
+   public:
+    explicit Batch(TinyGsmModem& modem)
+        : _modem(modem),
+          _last(&_skipped),
+          _head(0),
+          _count(0),
+          _bytes(0),
+          _failed(false) {}
+    ~Batch() {
+      done();
+    }
+
+    // Sends "AT" and the arguments; the command succeeds on OK
+    template <typename... Args>
+    Batch& add(Args&&... cmd) {
+      size_t len = _modem.commandLength(cmd...);
+      while (_count && (_count >= depth() ||
+                        _bytes + len > TINY_GSM_AT_WINDOW || newest().wait)) {
+        answer();
+      }
+      _skipped = Step();
+      _last    = &_skipped;
+      if (_failed) { return *this; }
+      _modem.thisModem().sendAT(cmd...);
+      _modem.batched++;
+      _last  = &_steps[(_head + _count++) % TINY_GSM_AT_PIPELINE];
+      *_last = Step();
+      _last->len = len;
+      _bytes += len;
+      return *this;
+    }
+
+    // The command also has to answer this, before or after its OK
+    Batch& expect(GsmConstStr response) {
+      _last->expect = response;
+      return *this;
+    }
+    // How long the answer may take, 1 s unless set
+    Batch& timeout(uint32_t timeout_ms) {
+      _last->timeout_ms = timeout_ms;
+      return *this;
+    }
+    // The command may fail without stopping the batch
+    Batch& optional() {
+      _last->optional = true;
+      return *this;
+    }
+    // Has *ok tell whether the command succeeded, once it is answered; left
+    // as it is if the command is not sent
+    Batch& result(bool* ok) {
+      _last->ok = ok;
+      return *this;
+    }
+    // The next command is held back until this one has been answered, for
+    // commands the modem takes a while over or that change how it listens
+    Batch& wait() {
+      _last->wait = true;
+      return *this;
+    }
+
+    // Reads the answers still due; true if no command failed
+    bool done() {
+      while (_count) { answer(); }
+      return !_failed;
+    }
+
+   private:
+    struct Step {
+      Step()
+          : expect(NULL),
+            timeout_ms(1000L),
+            len(0),
+            ok(NULL),
+            optional(false),
+            wait(false) {}
+      GsmConstStr expect;
+      uint32_t    timeout_ms;
+      size_t      len;
+      bool*       ok;
+      bool        optional;
+      bool        wait;
+    };
+
+    static uint8_t depth() {
+      return TinyGsmMin(modemType::atPipelineImpl(),
+                        static_cast<uint8_t>(TINY_GSM_AT_PIPELINE));
+    }
+
+    Step& newest() {
+      return _steps[(_head + _count - 1) % TINY_GSM_AT_PIPELINE];
+    }
+
+    void answer() {
+      Step& s = _steps[_head];
+      _head   = (_head + 1) % TINY_GSM_AT_PIPELINE;
+      _count--;
+      _modem.batched--;
+      _bytes -= s.len;
+      bool ok = _modem.waitCommandAnswer(s.expect, s.timeout_ms);
+      if (s.ok) { *s.ok = ok; }
+      if (!ok && !s.optional) { _failed = true; }
+    }
+
+    TinyGsmModem& _modem;
+    Step          _steps[TINY_GSM_AT_PIPELINE];
+    Step          _skipped;  // what the modifiers change after a skipped add
+    Step*         _last;
+    uint8_t       _head;
+    uint8_t       _count;
+    size_t        _bytes;  // unanswered command bytes
+    bool          _failed;
+  };
+
   void setBaud(uint32_t baud) {
+    TINY_GSM_MODEM_LOCK();
     thisModem().setBaudImpl(baud);
   }
   // Test response to AT commands
   bool testAT(uint32_t timeout_ms = 10000L) {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().testATImpl(timeout_ms);
   }
 
   // Asks for modem information via the V.25TER standard ATI command
   // NOTE:  The actual value and style of the response is quite varied
   String getModemInfo() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getModemInfoImpl();
   }
   // Gets the modem name (as it calls itself)
   String getModemName() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getModemNameImpl();
   }
   bool factoryDefault() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().factoryDefaultImpl();
   }
 
@@ -54,18 +317,26 @@ class TinyGsmModem {
    * Power functions
    */
   bool restart(const char* pin = NULL) {
+    TINY_GSM_MODEM_LOCK();
+    forgetNetwork();
     return thisModem().restartImpl(pin);
   }
   bool poweroff() {
+    TINY_GSM_MODEM_LOCK();
+    forgetNetwork();
     return thisModem().powerOffImpl();
   }
   bool radioOff() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().radioOffImpl();
   }
   bool sleepEnable(bool enable = true) {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().sleepEnableImpl(enable);
   }
   bool setPhoneFunctionality(uint8_t fun, bool reset = false) {
+    TINY_GSM_MODEM_LOCK();
+    forgetNetwork();
     return thisModem().setPhoneFunctionalityImpl(fun, reset);
   }
 
@@ -74,22 +345,130 @@ class TinyGsmModem {
    */
   // RegStatus getRegistrationStatus() {}
   bool isNetworkConnected() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().isNetworkConnectedImpl();
   }
+  // Location area (LAC or TAC), cell ID and access technology (<AcT> of
+  // 3GPP TS 27.007, -1 if not given) of the last registration report.
+  // False if the modem has not reported a cell yet.
+  bool getRegistrationInfo(uint32_t& area, uint32_t& cellId, int8_t& act) {
+    TINY_GSM_MODEM_LOCK();
+    if (!regCell && !regArea) { return false; }
+    area   = regArea;
+    cellId = regCell;
+    act    = regAct;
+    return true;
+  }
   // Waits for network attachment
   bool waitForNetwork(uint32_t timeout_ms = 60000L) {
     return thisModem().waitForNetworkImpl(timeout_ms);
   }
+  // The same in the background.  Once the modem reports its registration by
+  // itself, a check costs no round trip; the time between checks is left to
+  // the caller.
+  bool waitForNetwork(TinyGsmRequest& req, uint32_t timeout_ms = 60000L) {
+    req.timeout_ms = timeout_ms;
+    return startRequest(req, this, waitForNetworkStep);
+  }
   // Gets signal quality report
   int16_t getSignalQuality() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getSignalQualityImpl();
   }
   String getLocalIP() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getLocalIPImpl();
   }
+  // Kept while the bearer stays up, see isGprsConnected()
   IPAddress localIP() {
-    return thisModem().TinyGsmIpFromString(thisModem().getLocalIP());
+    TINY_GSM_MODEM_LOCK();
+    if (bearerIP != IPAddress(0, 0, 0, 0) && knownBearer() > 0) {
+      return bearerIP;
+    }
+    IPAddress ip = thisModem().TinyGsmIpFromString(thisModem().getLocalIP());
+    if (bearerState) { bearerIP = ip; }
+    return ip;
+  }
+
+  /*
+   * Signal monitor
+   */
+  // Samples the signal every interval_ms, from maintain().  Where the modem
+  // reports its signal by itself (see signalReportsImpl()) the reports are
+  // taken in instead, and it is asked when a report says to, and for RSRP
+  // and RSRQ every TINY_GSM_SIGNAL_REPORT_POLL intervals.
+  void startSignalMonitor(uint32_t interval_ms = 5000L) {
+    TINY_GSM_MODEM_LOCK();
+    signalInterval = interval_ms ? interval_ms : 1;
+    signalReports  = 0;
+  }
+  void stopSignalMonitor() {
+    TINY_GSM_MODEM_LOCK();
+    if (signalReports > 0) { thisModem().signalReportsImpl(false); }
+    signalInterval = 0;
+  }
+  // The samples so far, with their lowest, mean and latest values; reading
+  // them costs no round trip
+  TinyGsmSignalStats getSignalStats() {
+    TINY_GSM_MODEM_LOCK();
+    return signalStats;
+  }
+
+  /*
+   * Background requests
+   */
+  // Advances the request at the head of the queue by one step, without
+  // waiting for the modem.  Returns true while requests are left.
+  bool poll() {
+    TINY_GSM_MODEM_LOCK();
+    TinyGsmRequest* req = requests;
+    if (!req) { return false; }
+    if (req->_status == REQUEST_QUEUED) {
+      req->_status   = REQUEST_RUNNING;
+      req->_started  = millis();
+      req->_wait_ms  = 0;
+      req->_awaiting = false;
+    }
+    if (req->_awaiting) {
+      if (!awaitAnswer(*req)) { return true; }
+    } else if (req->_wait_ms) {
+      if (millis() - req->_since < req->_wait_ms) { return true; }
+      req->_wait_ms = 0;
+    }
+    stepRequest(*req);
+    return requests != NULL;
+  }
+
+  // Queues req to be run by `step` on `owner`, the object that started it;
+  // also how operations of the caller's own take their turn with the modem.
+  // A step must not call a blocking function that runs a request itself.
+  // Returns false if req is still busy.
+  bool startRequest(TinyGsmRequest& req, void* owner,
+                    TinyGsmRequest::Step step) {
+    TINY_GSM_MODEM_LOCK();
+    if (req.busy()) { return false; }
+    req.stage   = 0;
+    req.answer  = 0;
+    req._status = REQUEST_QUEUED;
+    req._step   = step;
+    req._owner  = owner;
+    req._next   = NULL;
+    TinyGsmRequest** tail = &requests;
+    while (*tail) { tail = &(*tail)->_next; }
+    *tail = &req;
+    return true;
+  }
+
+#if defined TINY_GSM_THREADED
+  /*
+   * Threads
+   */
+  // The lock each call holds while it talks to the modem.  Hold it as well to
+  // make several calls, or a Batch, one piece no other task comes between.
+  TinyGsmMutex& commandLock() {
+    return commandMutex;
   }
+#endif
 
   /*
    * CRTP Helper
@@ -102,6 +481,85 @@ class TinyGsmModem {
     return static_cast<modemType&>(*this);
   }
 
+  /*
+   * Background requests
+   */
+ protected:
+  // Runs the queue until req is done; what the blocking calls are made of
+  bool runRequest(TinyGsmRequest& req) {
+    while (req.busy()) {
+      uint32_t sleep_ms = 0;
+      {
+        TINY_GSM_MODEM_LOCK();
+        TinyGsmRequest* head = requests;
+        if (head && head->_status == REQUEST_RUNNING && !head->_awaiting &&
+            head->_wait_ms) {
+          uint32_t waited = millis() - head->_since;
+          if (waited < head->_wait_ms) { sleep_ms = head->_wait_ms - waited; }
+        }
+      }
+      // Without the lock, so that other tasks get their turn meanwhile
+      if (sleep_ms) { delay(sleep_ms); }
+      poll();
+      TINY_GSM_YIELD();
+    }
+    return req.ok();
+  }
+
+  // Has the next step of req wait for the answer to the command it just
+  // sent: r1 (OK unless given), ERROR, a +CME or +CMS error report, or r2.
+  // The step finds the index of the answer in req.answer, or -1 if none came
+  // within timeout_ms.
+  void expectAnswer(TinyGsmRequest& req, uint32_t timeout_ms,
+                    GsmConstStr r1 = NULL, GsmConstStr r2 = NULL) {
+    beginResponse(requestCtx, NULL, r1 ? r1 : GF("OK\r\n"), GF("ERROR\r\n"),
+                  GF("\r\n+CME ERROR:"), GF("\r\n+CMS ERROR:"), r2, NULL);
+    req.answer    = 0;
+    req._awaiting = true;
+    req._since    = millis();
+    req._wait_ms  = timeout_ms;
+  }
+
+  // Has the next step of req run no sooner than wait_ms from now
+  void sleepRequest(TinyGsmRequest& req, uint32_t wait_ms) {
+    req._since   = millis();
+    req._wait_ms = wait_ms;
+  }
+
+  // Reads what has come of the answer req is waiting for.  Returns true once
+  // it is complete or has timed out.
+  bool awaitAnswer(TinyGsmRequest& req) {
+    uint8_t index = feedResponse(requestCtx);
+    if (!index && millis() - req._since < req._wait_ms) { return false; }
+    req.answer    = index ? index : -1;
+    req._awaiting = false;
+    req._wait_ms  = 0;
+    return true;
+  }
+
+  // Runs the next step of req, the head of the queue, and takes req off the
+  // queue once it is done
+  void stepRequest(TinyGsmRequest& req) {
+    req._step(req._owner, req);
+    if (!req.busy()) {
+      requests  = req._next;
+      req._next = NULL;
+      if (req._done) { req._done(req, req._arg); }
+    }
+  }
+
+  // Lets the command a request is waiting on be answered before the stream
+  // is used for anything else.  The step after the answer runs right away,
+  // as it may expect more from the modem (e.g. a URC after the OK) that the
+  // caller would otherwise read.
+  void settleRequest() {
+    TinyGsmRequest* req;
+    while ((req = requests) != NULL && req->_awaiting) {
+      while (!awaitAnswer(*req)) { TINY_GSM_YIELD(); }
+      stepRequest(*req);
+    }
+  }
+
   /*
    * Basic functions
    */
@@ -185,34 +643,200 @@ class TinyGsmModem {
   // CREG = Generic network registration
   // CGREG = GPRS service registration
   // CEREG = EPS registration for LTE modules
+  // The first call turns on the modem's reports (<n> = 2); from then on the
+  // status is what they said, and the modem is only asked again after
+  // TINY_GSM_REG_RESYNC ms or once init() or restart() has run.
   int8_t getRegistrationStatusXREG(const char* regCommand) {
+    RegDomain& reg = regDomains[regDomainIndex(regCommand)];
+    if (reg.reports > 0 && millis() - reg.synced < TINY_GSM_REG_RESYNC) {
+      takeUrcs();
+      return reg.stat;
+    }
+    if (!reg.reports) {
+      thisModem().sendAT('+', regCommand, GF("=2"));
+      reg.reports = thisModem().waitResponse() == 1 ? 1 : -1;
+    }
     thisModem().sendAT('+', regCommand, '?');
-    // check for any of the three for simplicity
-    int8_t resp = thisModem().waitResponse(GF("+CREG:"), GF("+CGREG:"),
-                                           GF("+CEREG:"));
-    if (resp != 1 && resp != 2 && resp != 3) { return -1; }
-    thisModem().streamSkipUntil(','); /* Skip format (0) */
-    int status = thisModem().stream.parseInt();
+    TinyGsmFields fields;
+    int8_t        resp;
+    for (;;) {
+      // check for any of the three for simplicity
+      resp = thisModem().waitResponse(GF("+CREG:"), GF("+CGREG:"),
+                                      GF("+CEREG:"));
+      if (resp != 1 && resp != 2 && resp != 3) {
+        reg.reports = 0;  // not in sync; start over next time
+        return -1;
+      }
+      // <n>,<stat>[,<lac>,<ci>[,<AcT>]], unless a report came first
+      thisModem().streamGetFields(fields);
+      if (isRegistrationAnswer(fields)) { break; }
+      takeRegistrationReport(resp - 1, fields);
+    }
     thisModem().waitResponse();
-    return status;
+    storeRegistration(resp - 1, fields, 1);
+    regDomains[resp - 1].synced = millis();
+    return regDomains[resp - 1].stat;
   }
 
-  bool waitForNetworkImpl(uint32_t timeout_ms = 60000L) {
-    for (uint32_t start = millis(); millis() - start < timeout_ms;) {
-      if (thisModem().isNetworkConnected()) { return true; }
-      delay(250);
+  // Whether the bearer is up (1) or down (0) as last found, or -1 if the
+  // modem has to be asked.  The first call turns on the modem's reports of
+  // bearer events (see bearerReportsImpl()); without them nothing is kept.
+  int8_t knownBearer() {
+    if (!bearerReports) {
+      bearerReports = thisModem().bearerReportsImpl() ? 1 : -1;
+    }
+    if (bearerReports < 0 || bearerState < 0 ||
+        millis() - bearerSynced >= TINY_GSM_REG_RESYNC) {
+      return -1;
     }
+    takeUrcs();
+    return bearerState;
+  }
+
+  void storeBearer(bool up) {
+    bearerState  = up;
+    bearerSynced = millis();
+    if (!up) { bearerIP = IPAddress(0, 0, 0, 0); }
+  }
+
+  // Has the next knownBearer() ask the modem, e.g. once the bearer may have
+  // gone down
+  void forgetBearer() {
+    bearerState = -1;
+    bearerIP    = IPAddress(0, 0, 0, 0);
+  }
+
+  // Turns on the modem's bearer event reports, +CGEV.  False if it has none,
+  // and so the state of the bearer cannot be kept.
+  bool bearerReportsImpl() {
+    thisModem().sendAT(GF("+CGEREP=2,1"));
+    return thisModem().waitResponse() == 1;
+  }
+
+  // True while a connection has the UART to itself in a transparent data
+  // mode (see the SIM800 and SIM7000): nothing the modem sends is then an
+  // answer or a URC, and a command first has leaveDataModeImpl() take the
+  // modem back to command mode; if that fails the command is not sent
+  bool inDataModeImpl() {
+    return false;
+  }
+  void leaveDataModeImpl() {}
+
+  // How many commands a Batch may leave unanswered.  Pipelining is for the
+  // drivers whose modems are known to take commands back to back (see the
+  // BG96); the others send one and wait for its answer.
+  static uint8_t atPipelineImpl() {
+    return 1;
+  }
+
+  // Runs before every command that has no other one waiting for its answer,
+  // for the driver to send one of its own first, e.g. to stop the modem
+  // pushing data a client has no room for (see the BG96)
+  void beforeCommandImpl() {}
+
+  // True while the driver would rather leave what the modem sends unasked on
+  // the line until the next command, e.g. while a client is short of room for
+  // the data the modem pushes (see the BG96); takeUrcs() then returns
+  bool holdUrcsImpl() {
     return false;
   }
 
+  // Has the modem asked again for its registration and bearer, and its signal
+  // reports turned on again, e.g. after it has been reset and forgot them
+  void forgetNetwork() {
+    for (uint8_t i = 0; i < 3; i++) { regDomains[i].reports = 0; }
+    bearerReports = 0;
+    forgetBearer();
+    signalReports = 0;
+  }
+
+  // Hands the URCs already waiting in the stream to their handlers.  Text
+  // that is not a whole URC yet gets 15 ms to arrive in full; once a URC has
+  // been taken, or only blanks follow it (e.g. the space of a "> " prompt),
+  // there is nothing to wait for.
+  void takeUrcs() {
+    settleRequest();
+    while (!thisModem().inDataModeImpl() && !thisModem().holdUrcsImpl() &&
+           thisModem().stream.available()) {
+      UrcContext ctx;
+      beginResponse(ctx, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+      uint32_t startMillis = millis();
+      do {
+        TINY_GSM_YIELD();
+        feedResponse(ctx);
+      } while (!ctx.seen.blank() && !thisModem().inDataModeImpl() &&
+               !thisModem().holdUrcsImpl() && millis() - startMillis < 15);
+    }
+  }
+
+  bool waitForNetworkImpl(uint32_t timeout_ms = 60000L) {
+    TinyGsmRequest req;
+    waitForNetwork(req, timeout_ms);
+    return runRequest(req);
+  }
+
+  static void waitForNetworkStep(void* owner, TinyGsmRequest& req) {
+    TinyGsmModem& modem = *static_cast<TinyGsmModem*>(owner);
+    if (modem.thisModem().isNetworkConnected()) {
+      req.finish(REQUEST_OK);
+    } else if (req.elapsed() >= req.timeout_ms) {
+      req.finish(REQUEST_TIMEOUT);
+    } else {
+      modem.sleepRequest(req, 250);
+    }
+  }
+
   // Gets signal quality report according to 3GPP TS command AT+CSQ
   // picsil: modified to use +CESQ instead
   int8_t getSignalQualityImpl() {
     thisModem().sendAT(GF("+CESQ"));
     if (thisModem().waitResponse(GF("+CESQ:")) != 1) { return 99; }
-    int8_t res = thisModem().streamGetIntBefore(',');
+    // <rxlev>,<ber>,<rscp>,<ecno>,<rsrq>,<rsrp>
+    TinyGsmFields fields;
+    thisModem().streamGetFields(fields);
     thisModem().waitResponse();
-    return res;
+    return fields.toInt(0);
+  }
+
+  // Takes a sample for the signal monitor via +CESQ
+  bool getSignalSampleImpl(TinyGsmSignalSample& sample) {
+    thisModem().sendAT(GF("+CESQ"));
+    if (thisModem().waitResponse(GF("+CESQ:")) != 1) { return false; }
+    // <rxlev>,<ber>,<rscp>,<ecno>,<rsrq>,<rsrp>
+    TinyGsmFields fields;
+    thisModem().streamGetFields(fields);
+    thisModem().waitResponse();
+    sample      = TinyGsmSignalSample();
+    sample.rssi = TinyGsmSignalSample::fromRxlev(fields.toInt(0));
+    sample.rsrq = TinyGsmSignalSample::fromRsrq(fields.toInt(4));
+    sample.rsrp = TinyGsmSignalSample::fromRsrp(fields.toInt(5));
+    return sample.rssi || sample.rsrq || sample.rsrp;
+  }
+
+  // Turns the modem's own signal reports on or off.  False if it has none;
+  // drivers that have them list onSignalReport() or onIndicator() in their
+  // urcTable() as well.
+  bool signalReportsImpl(bool) {
+    return false;
+  }
+
+  // Takes a sample if the signal monitor is due one; maintain() calls this
+  void maintainSignal() {
+    if (!signalInterval) { return; }
+    if (!signalReports) {
+      signalReports = thisModem().signalReportsImpl(true) ? 1 : -1;
+      signalDue     = true;
+    }
+    uint32_t interval = signalInterval;
+    if (signalReports > 0) { interval *= TINY_GSM_SIGNAL_REPORT_POLL; }
+    if (!signalDue && millis() - signalPolled < interval) { return; }
+    signalDue    = false;
+    signalPolled = millis();
+    TinyGsmSignalSample sample;
+    if (thisModem().getSignalSampleImpl(sample)) {
+      sample.at = signalPolled;
+      signalStats.add(sample);
+    }
   }
 
   String getLocalIPImpl() {
@@ -245,6 +869,273 @@ class TinyGsmModem {
     return IPAddress(Parts[0], Parts[1], Parts[2], Parts[3]);
   }
 
+  /*
+   * Response parsing
+   */
+ protected:
+  // What a URC handler gets to see of the response it interrupted
+  struct UrcContext {
+    String*                             data;  // the caller's copy, or NULL
+    TinyGsmRing<TINY_GSM_RESPONSE_RING> seen;  // the text up to the prefix
+#if defined TINY_GSM_DEBUG
+    GsmConstStr expected[6];
+#endif
+  };
+
+  // Called with the stream positioned right after the prefix.  Returns false
+  // if the text belongs to the response after all, so it is kept.
+  typedef bool (modemType::*UrcHandler)(UrcContext& ctx);
+
+  // Drivers list their URCs in a table ending with {"", NULL}, and return it
+  // from a static urcTable() along with the trie of its prefixes, which the
+  // compiler works out:
+  //
+  //   static UrcTable urcTable() {
+  //     static constexpr Urc urcs[] TINY_GSM_PROGMEM = {..., {"", NULL}};
+  //     typedef TinyGsmTrie<TinyGsmTrieSize(urcs)> Trie;
+  //     static constexpr Trie trie TINY_GSM_PROGMEM = Trie::of(urcs);
+  //     return {urcs, trie.nodes};
+  //   }
+  //
+  // Both live in flash; the prefixes are matched anywhere in the output, all
+  // at once, so a longer table costs nothing per character.
+  struct Urc {
+    char       prefix[TINY_GSM_URC_PREFIX];
+    UrcHandler handler;
+  };
+  struct UrcTable {
+    const Urc*             urcs;
+    const TinyGsmTrieNode* trie;
+  };
+
+  // Reads until one of r1..r6 arrives or the time runs out, handing the URCs
+  // found on the way to their handlers.  Returns the index of the response,
+  // or 0 on timeout.
+  int8_t parseResponse(uint32_t timeout_ms, String* data, GsmConstStr r1,
+                       GsmConstStr r2, GsmConstStr r3, GsmConstStr r4,
+                       GsmConstStr r5, GsmConstStr r6 = NULL) {
+    settleRequest();
+    // What a modem sends in data mode belongs to the connection
+    if (thisModem().inDataModeImpl()) { return 0; }
+    UrcContext ctx;
+    beginResponse(ctx, data, r1, r2, r3, r4, r5, r6);
+    uint8_t  index       = 0;
+    uint32_t startMillis = millis();
+    do {
+      TINY_GSM_YIELD();
+      index = feedResponse(ctx);
+    } while (!index && millis() - startMillis < timeout_ms);
+    if (!index) {
+#if defined TINY_GSM_DEBUG
+      String unhandled = data ? *data : ctx.seen.toString();
+      unhandled.trim();
+      if (unhandled.length()) { DBG("### Unhandled:", unhandled); }
+#endif
+      if (data) { *data = ""; }
+    }
+    return index;
+  }
+
+  // Sets up reading a response made of r1..r6, to be fed by feedResponse()
+  void beginResponse(UrcContext& ctx, String* data, GsmConstStr r1,
+                     GsmConstStr r2, GsmConstStr r3, GsmConstStr r4,
+                     GsmConstStr r5, GsmConstStr r6) {
+    responseMatcher.expect(r1, r2, r3, r4, r5, r6);
+    urcMatcher.reset();
+    ctx.data = data;
+    ctx.seen.clear();
+    if (data) { data->reserve(64); }
+#if defined TINY_GSM_DEBUG
+    ctx.expected[0] = r1;
+    ctx.expected[1] = r2;
+    ctx.expected[2] = r3;
+    ctx.expected[3] = r4;
+    ctx.expected[4] = r5;
+    ctx.expected[5] = r6;
+#endif
+  }
+
+  // Reads what the stream has, without waiting for more.  Returns the index
+  // of the response once it is complete, else 0, also as soon as a URC has
+  // been handled.
+  uint8_t feedResponse(UrcContext& ctx) {
+    const UrcTable urcs = modemType::urcTable();
+    while (thisModem().stream.available() > 0) {
+      TINY_GSM_YIELD();
+      int8_t a = thisModem().stream.read();
+      if (a <= 0) continue;  // Skip 0x00 bytes, just in case
+      ctx.seen.put(a);
+      if (ctx.data) { *ctx.data += static_cast<char>(a); }
+      uint8_t index = responseMatcher.feed(a);
+      if (index) {
+#if defined TINY_GSM_DEBUG
+        if (isErrorReport(ctx.expected[index - 1])) {
+          thisModem().streamSkipUntil('\n');  // Read out the error
+        }
+#endif
+        return index;
+      }
+      uint8_t urc = urcMatcher.feed(urcs.trie, a);
+      if (!urc) continue;
+      if (!(thisModem().*urcHandler(urcs.urcs, urc))(ctx)) continue;
+      // The URC has been dealt with, start afresh
+      if (ctx.data) { *ctx.data = ""; }
+      ctx.seen.clear();
+      responseMatcher.reset();
+      urcMatcher.reset();
+      // Back to the caller, which may act on what the URC changed
+      return 0;
+    }
+    return 0;
+  }
+
+  static UrcHandler urcHandler(const Urc* urcs, uint8_t id) {
+#if defined(__AVR__) && !defined(__AVR_ATmega4809__)
+    UrcHandler handler;
+    memcpy_P(&handler, &urcs[id - 1].handler, sizeof(handler));
+    return handler;
+#else
+    return urcs[id - 1].handler;
+#endif
+  }
+
+  // Registration reports, for the drivers to list in their urcTable()
+  bool onCreg(UrcContext& ctx) {
+    return onRegistration(ctx, 0);
+  }
+  bool onCgreg(UrcContext& ctx) {
+    return onRegistration(ctx, 1);
+  }
+  bool onCereg(UrcContext& ctx) {
+    return onRegistration(ctx, 2);
+  }
+
+  bool onRegistration(UrcContext& ctx, uint8_t domain) {
+    TinyGsmFields fields;
+    thisModem().streamGetFields(fields);
+    if (!isRegistrationAnswer(fields)) {
+      return takeRegistrationReport(domain, fields);
+    }
+    storeRegistration(domain, fields, 1);
+    // Not a report after all; the caller gets the line back
+    if (ctx.data) {
+      for (uint8_t i = 0; i < fields.count(); i++) {
+        *ctx.data += i ? ',' : ' ';
+        *ctx.data += fields.str(i);
+      }
+      *ctx.data += "\r\n";
+    }
+    return false;
+  }
+
+  // A report starts with <stat>, followed by the hex <lac> if anything; the
+  // answer to a query starts with <n>, followed by the one digit <stat>
+  static bool isRegistrationAnswer(const TinyGsmFields& fields) {
+    return fields.count() >= 2 && strlen(fields.str(1)) == 1;
+  }
+
+  // Takes in a report; true, for the URC handler to return
+  bool takeRegistrationReport(uint8_t domain, const TinyGsmFields& fields) {
+    int8_t before = regDomains[domain].stat;
+    storeRegistration(domain, fields, 0);
+    // The bearer may not have survived a change of registration
+    if (regDomains[domain].stat != before) { forgetBearer(); }
+    return true;
+  }
+
+  // Takes in <stat>[,<lac>,<ci>[,<AcT>]], starting at field `first`
+  void storeRegistration(uint8_t domain, const TinyGsmFields& fields,
+                         uint8_t first) {
+    regDomains[domain].stat = fields.toInt(first, -1);
+    if (!fields.has(first + 2)) { return; }
+    regArea = strtoul(fields.str(first + 1), NULL, 16);
+    regCell = strtoul(fields.str(first + 2), NULL, 16);
+    regAct  = fields.toInt(first + 3, -1);
+  }
+
+  // Bearer events, +CGEV (3GPP) and +PDP: DEACT (SIMCom), for the drivers to
+  // list in their urcTable()
+  bool onBearerEvent(UrcContext&) {
+    thisModem().streamSkipUntil('\n');
+    forgetBearer();
+    return true;
+  }
+
+  // Signal reports of <rssi>,<ber> as in +CSQ (SIMCom +CSQN or AUTOCSQ,
+  // Quectel +QIND: "csq"), for the drivers to list in their urcTable()
+  bool onSignalReport(UrcContext&) {
+    TinyGsmFields fields;
+    thisModem().streamGetFields(fields);
+    TinyGsmSignalSample sample;
+    sample.rssi = TinyGsmSignalSample::fromCsq(fields.toInt(0));
+    sample.at   = millis();
+    if (signalInterval && sample.rssi) { signalStats.add(sample); }
+    return true;
+  }
+
+  // +CIEV indicator events; a change of the signal indicator (2, in bars)
+  // has the monitor take a sample on the next maintain()
+  bool onIndicator(UrcContext&) {
+    TinyGsmFields fields;
+    thisModem().streamGetFields(fields);
+    if (fields.toInt(0) == 2) { signalDue = true; }
+    return true;
+  }
+
+  // CREG, CGREG or CEREG
+  static uint8_t regDomainIndex(const char* regCommand) {
+    return regCommand[1] == 'G' ? 1 : regCommand[1] == 'E' ? 2 : 0;
+  }
+
+  // Length of the line sendAT() makes of these arguments
+  template <typename... Args>
+  size_t commandLength(Args&&... cmd) {
+    TinyGsmPrintCounter len;
+    len.add("AT", cmd..., thisModem().gsmNL);
+    return len.count;
+  }
+
+  // Reads the answer to a command: OK, and `expect` as well unless that is
+  // NULL.  `expect` may come before the OK or after it.
+  bool waitCommandAnswer(GsmConstStr expect, uint32_t timeout_ms) {
+    if (!expect) { return thisModem().waitResponse(timeout_ms) == 1; }
+    String   data;
+    uint32_t startMillis = millis();
+    if (thisModem().waitResponse(timeout_ms, data) != 1) { return false; }
+    if (textContains(data, expect)) { return true; }
+    uint32_t elapsed = millis() - startMillis;
+    return elapsed < timeout_ms &&
+           thisModem().waitResponse(timeout_ms - elapsed, expect) == 1;
+  }
+
+  static bool textContains(const String& text, GsmConstStr r) {
+    for (size_t i = 0; TinyGsmPatternChar(r, 0) && i < text.length(); i++) {
+      size_t k = 0;
+      while (i + k < text.length() &&
+             TinyGsmPatternChar(r, k) == text[i + k]) {
+        k++;
+      }
+      if (!TinyGsmPatternChar(r, k)) { return true; }
+    }
+    return !TinyGsmPatternChar(r, 0);
+  }
+
+#if defined TINY_GSM_DEBUG
+  // "+CME ERROR:" and the like, which are followed by the error text
+  static bool isErrorReport(GsmConstStr r) {
+    static const char suffix[] = "ERROR:";
+    size_t            len      = 0;
+    while (TinyGsmPatternChar(r, len)) { len++; }
+    if (len < sizeof(suffix) - 1) { return false; }
+    for (size_t i = 0; i < sizeof(suffix) - 1; i++) {
+      if (TinyGsmPatternChar(r, len - sizeof(suffix) + 1 + i) != suffix[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+#endif
+
   /*
    Utilities
    */
@@ -262,7 +1153,7 @@ class TinyGsmModem {
   }
 
   inline void streamClear() {
-    while (thisModem().stream.available()) {
+    while (!thisModem().inDataModeImpl() && thisModem().stream.available()) {
       thisModem().waitResponse(50, NULL, NULL);
     }
   }
@@ -337,6 +1228,24 @@ class TinyGsmModem {
     return -9999.0F;
   }
 
+  // Reads the rest of the current line in one pass and splits it into fields.
+  // Returns the number of fields, 0 if the line did not end in time.
+  inline uint8_t streamGetFields(TinyGsmFields& fields,
+                                 const uint32_t timeout_ms = 1000L) {
+    fields.clear();
+    uint32_t startMillis = millis();
+    while (millis() - startMillis < timeout_ms) {
+      int c = thisModem().stream.read();
+      if (c < 0) {
+        TINY_GSM_YIELD();
+      } else if (fields.put(c)) {
+        return fields.count();
+      }
+    }
+    fields.end();
+    return 0;
+  }
+
   inline bool streamSkipUntil(const char c, const uint32_t timeout_ms = 1000L) {
     uint32_t startMillis = millis();
     while (millis() - startMillis < timeout_ms) {
@@ -348,6 +1257,39 @@ class TinyGsmModem {
     }
     return false;
   }
+
+  TinyGsmResponseMatcher responseMatcher;
+  TinyGsmTrieMatcher     urcMatcher;
+  TinyGsmRequest* requests = NULL;  // the queue, running one at the head
+  UrcContext      requestCtx;       // of the answer it is waiting for
+  uint8_t         batched = 0;      // Batch commands not answered yet
+
+  // Registration as last reported, per CREG, CGREG and CEREG
+  struct RegDomain {
+    int8_t   stat;
+    int8_t   reports;  // 1 if the modem sends them, -1 if it would not
+    uint32_t synced;   // millis() of the last query
+  };
+  RegDomain regDomains[3] = {};
+  uint32_t  regArea       = 0;  // LAC or TAC
+  uint32_t  regCell       = 0;
+  int8_t    regAct        = -1;
+
+  // The bearer as last found: 1 up, 0 down, -1 unknown
+  int8_t    bearerState   = -1;
+  int8_t    bearerReports = 0;  // 1 if the modem sends them, -1 if it would not
+  uint32_t  bearerSynced  = 0;  // millis() of the last query
+  IPAddress bearerIP;
+
+  // The signal monitor, sampling every signalInterval ms unless 0
+  TinyGsmSignalStats signalStats;
+  uint32_t           signalInterval = 0;
+  uint32_t           signalPolled   = 0;  // millis() of the last sample
+  int8_t             signalReports  = 0;  // 1 if the modem sends them
+  bool               signalDue      = false;  // sample on the next maintain()
+#if defined TINY_GSM_THREADED
+  TinyGsmMutex commandMutex;
+#endif
 };
 
 #endif  // SRC_TINYGSMMODEM_H_
@@ -0,0 +1,109 @@
+/**
+ * @file       TinyGsmRequest.h
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Oct 2026
+ */
+
+#ifndef SRC_TINYGSMREQUEST_H_
+#define SRC_TINYGSMREQUEST_H_
+
+#include "TinyGsmCommon.h"
+
+enum RequestStatus {
+  REQUEST_IDLE    = 0,  // never started
+  REQUEST_QUEUED  = 1,  // waiting for the requests before it
+  REQUEST_RUNNING = 2,
+  REQUEST_OK      = 3,
+  REQUEST_FAILED  = 4,
+  REQUEST_TIMEOUT = 5,
+};
+
+// An operation that runs in the background, e.g.
+//
+//   TinyGsmRequest net;
+//   modem.waitForNetwork(net);
+//   while (net.busy()) {
+//     modem.poll();
+//     // ... other work ...
+//   }
+//   if (net.status() == REQUEST_OK) { ... }
+//
+// Starting a request queues it on the modem; poll() advances the one at the
+// head of the queue a step at a time and never waits for the modem.  The
+// caller owns the request, and whatever was passed to start it, until it is
+// done; it can then be started again.
+class TinyGsmRequest {
+ public:
+  typedef void (*Callback)(TinyGsmRequest& req, void* arg);
+  // One step of the operation, for the modem (or mixin) `owner`
+  typedef void (*Step)(void* owner, TinyGsmRequest& req);
+
+  TinyGsmRequest()
+      : stage(0),
+        answer(0),
+        timeout_ms(0),
+        _status(REQUEST_IDLE),
+        _done(NULL),
+        _arg(NULL),
+        _next(NULL) {}
+
+  RequestStatus status() const {
+    return _status;
+  }
+  bool busy() const {
+    return _status == REQUEST_QUEUED || _status == REQUEST_RUNNING;
+  }
+  bool ok() const {
+    return _status == REQUEST_OK;
+  }
+
+  // Called from poll() once the request is done.  The request may be started
+  // again from the callback.
+  void onDone(Callback callback, void* arg = NULL) {
+    _done = callback;
+    _arg  = arg;
+  }
+
+  // Milliseconds since the request started running
+  uint32_t elapsed() const {
+    return millis() - _started;
+  }
+
+  /*
+   * For the operation's steps
+   */
+  uint8_t     stage;       // where the operation is, 0 at the start
+  int8_t      answer;      // index of the response awaited, -1 on timeout
+  uint32_t    timeout_ms;  // for the whole operation
+  const char* str[2];      // what the operation was started with
+  int32_t     num[3];
+
+  void finish(RequestStatus status) {
+    _status = status;
+  }
+  // Ends the request as the last answer says: OK if it was the first response
+  // expected, a timeout if none came
+  void finishByAnswer() {
+    finish(answer == 1 ? REQUEST_OK
+                       : answer < 0 ? REQUEST_TIMEOUT : REQUEST_FAILED);
+  }
+
+ private:
+  template <class modemType>
+  friend class TinyGsmModem;
+
+  RequestStatus   _status;
+  Step            _step;
+  void*           _owner;
+  Callback        _done;
+  void*           _arg;
+  TinyGsmRequest* _next;     // queued after this one
+  uint32_t        _started;  // millis() when it started running
+  uint32_t        _since;    // millis() when the step began to wait
+  uint32_t        _wait_ms;  // how long it waits for, or for its answer
+  bool            _awaiting;  // a command's answer is being waited for
+};
+
+#endif  // SRC_TINYGSMREQUEST_H_
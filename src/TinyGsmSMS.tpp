@@ -10,6 +10,7 @@
 #define SRC_TINYGSMSMS_H_
 
 #include "TinyGsmCommon.h"
+#include "TinyGsmThread.h"
 
 #define TINY_GSM_MODEM_HAS_SMS
 
@@ -20,12 +21,18 @@ class TinyGsmSMS {
    * Messaging functions
    */
   String sendUSSD(const String& code) {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().sendUSSDImpl(code);
   }
   bool sendSMS(const String& number, const String& text) {
     return thisModem().sendSMSImpl(number, text);
   }
+  // The same in the background; number and text have to outlive the request
+  bool sendSMS(TinyGsmRequest& req, const char* number, const char* text) {
+    return thisModem().sendSMSRequestImpl(req, number, text);
+  }
   bool sendSMS_UTF16(const char* const number, const void* text, size_t len) {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().sendSMS_UTF16Impl(number, text, len);
   }
 
@@ -137,18 +144,48 @@ class TinyGsmSMS {
   }
 
   bool sendSMSImpl(const String& number, const String& text) {
-    // Set preferred message format to text mode
-    thisModem().sendAT(GF("+CMGF=1"));
-    thisModem().waitResponse();
-    // Set GSM 7 bit default alphabet (3GPP TS 23.038)
-    thisModem().sendAT(GF("+CSCS=\"GSM\""));
-    thisModem().waitResponse();
-    thisModem().sendAT(GF("+CMGS=\""), number, GF("\""));
-    if (thisModem().waitResponse(GF(">")) != 1) { return false; }
-    thisModem().stream.print(text);  // Actually send the message
-    thisModem().stream.write(static_cast<char>(0x1A));  // Terminate the message
-    thisModem().stream.flush();
-    return thisModem().waitResponse(60000L) == 1;
+    TinyGsmRequest req;
+    thisModem().sendSMSRequestImpl(req, number.c_str(), text.c_str());
+    return thisModem().runRequest(req);
+  }
+
+  bool sendSMSRequestImpl(TinyGsmRequest& req, const char* number,
+                          const char* text) {
+    req.str[0]     = number;
+    req.str[1]     = text;
+    req.timeout_ms = 60000L;
+    return thisModem().startRequest(req, this, sendSMSStep);
+  }
+
+  static void sendSMSStep(void* owner, TinyGsmRequest& req) {
+    modemType& at = static_cast<TinyGsmSMS*>(owner)->thisModem();
+    switch (req.stage++) {
+      case 0:
+        // Set preferred message format to text mode
+        at.sendAT(GF("+CMGF=1"));
+        at.expectAnswer(req, 1000L);
+        break;
+      case 1:
+        // Set GSM 7 bit default alphabet (3GPP TS 23.038)
+        at.sendAT(GF("+CSCS=\"GSM\""));
+        at.expectAnswer(req, 1000L);
+        break;
+      case 2:
+        at.sendAT(GF("+CMGS=\""), req.str[0], GF("\""));
+        at.expectAnswer(req, 1000L, GF(">"));
+        break;
+      case 3:
+        if (req.answer != 1) {
+          req.finish(REQUEST_FAILED);
+          break;
+        }
+        at.stream.print(req.str[1]);  // Actually send the message
+        at.stream.write(static_cast<char>(0x1A));  // Terminate the message
+        at.stream.flush();
+        at.expectAnswer(req, req.timeout_ms);
+        break;
+      default: req.finishByAnswer();
+    }
   }
 
   // Common methods for UTF8/UTF16 SMS.
@@ -10,6 +10,7 @@
 #define SRC_TINYGSMSSL_H_
 
 #include "TinyGsmCommon.h"
+#include "TinyGsmThread.h"
 
 #define TINY_GSM_MODEM_HAS_SSL
 
@@ -21,9 +22,11 @@ class TinyGsmSSL {
    * SSL functions
    */
   bool addCertificate(const char* filename) {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().addCertificateImpl(filename);
   }
   bool deleteCertificate() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().deleteCertificateImpl();
   }
 
@@ -0,0 +1,116 @@
+/**
+ * @file       TinyGsmSignal.h
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Oct 2026
+ */
+
+#ifndef SRC_TINYGSMSIGNAL_H_
+#define SRC_TINYGSMSIGNAL_H_
+
+#include "TinyGsmCommon.h"
+
+// Samples the signal monitor keeps
+#ifndef TINY_GSM_SIGNAL_SAMPLES
+#define TINY_GSM_SIGNAL_SAMPLES 8
+#endif
+
+// While the modem reports its signal by itself, the monitor still asks for a
+// full sample this many times less often: most reports carry the RSSI alone
+#ifndef TINY_GSM_SIGNAL_REPORT_POLL
+#define TINY_GSM_SIGNAL_REPORT_POLL 6
+#endif
+
+// One reading of the signal: RSSI and RSRP in dBm, RSRQ in dB.  A value the
+// modem did not give is 0.
+struct TinyGsmSignalSample {
+  TinyGsmSignalSample() : rssi(0), rsrp(0), rsrq(0), at(0) {}
+
+  int16_t  rssi;
+  int16_t  rsrp;
+  int16_t  rsrq;
+  uint32_t at;  // millis() when taken
+
+  // From the indices of 3GPP TS 27.007: +CSQ <rssi>, +CESQ <rxlev>, <rsrq>
+  // and <rsrp>; 0 for "not known"
+  static int16_t fromCsq(int16_t rssi) {
+    return rssi >= 0 && rssi <= 31 ? -113 + 2 * rssi : 0;
+  }
+  static int16_t fromRxlev(int16_t rxlev) {
+    return rxlev >= 0 && rxlev <= 63 ? -111 + rxlev : 0;
+  }
+  static int16_t fromRsrq(int16_t rsrq) {
+    return rsrq >= 0 && rsrq <= 34 ? -20 + rsrq / 2 : 0;
+  }
+  static int16_t fromRsrp(int16_t rsrp) {
+    return rsrp >= 0 && rsrp <= 97 ? -141 + rsrp : 0;
+  }
+};
+
+// Lowest, mean and latest of one reading, over the samples that have it
+struct TinyGsmSignalRange {
+  int16_t min;
+  int16_t avg;
+  int16_t last;
+  uint8_t count;  // samples it was taken from; the rest is 0 if none
+};
+
+// The last TINY_GSM_SIGNAL_SAMPLES samples.  Everything is worked out when
+// asked, from at most that many samples, so adding one costs nothing.
+class TinyGsmSignalStats {
+ public:
+  TinyGsmSignalStats() : _head(0), _count(0) {}
+
+  void add(const TinyGsmSignalSample& sample) {
+    _samples[_head] = sample;
+    _head           = (_head + 1) % TINY_GSM_SIGNAL_SAMPLES;
+    if (_count < TINY_GSM_SIGNAL_SAMPLES) { _count++; }
+  }
+
+  uint8_t count() const {
+    return _count;
+  }
+  // The newest sample, or an empty one if there is none
+  TinyGsmSignalSample last() const {
+    if (!_count) { return TinyGsmSignalSample(); }
+    return _samples[(_head + TINY_GSM_SIGNAL_SAMPLES - 1) %
+                    TINY_GSM_SIGNAL_SAMPLES];
+  }
+
+  TinyGsmSignalRange rssi() const {
+    return range(&TinyGsmSignalSample::rssi);
+  }
+  TinyGsmSignalRange rsrp() const {
+    return range(&TinyGsmSignalSample::rsrp);
+  }
+  TinyGsmSignalRange rsrq() const {
+    return range(&TinyGsmSignalSample::rsrq);
+  }
+
+ private:
+  TinyGsmSignalRange range(int16_t TinyGsmSignalSample::*value) const {
+    TinyGsmSignalRange r = {0, 0, 0, 0};
+    int32_t            sum = 0;
+    // Oldest first, so that the last one seen is the latest
+    for (uint8_t i = 0; i < _count; i++) {
+      const TinyGsmSignalSample& s =
+          _samples[(_head + TINY_GSM_SIGNAL_SAMPLES - _count + i) %
+                   TINY_GSM_SIGNAL_SAMPLES];
+      int16_t v = s.*value;
+      if (!v) { continue; }
+      if (!r.count || v < r.min) { r.min = v; }
+      r.last = v;
+      sum += v;
+      r.count++;
+    }
+    if (r.count) { r.avg = sum / r.count; }
+    return r;
+  }
+
+  TinyGsmSignalSample _samples[TINY_GSM_SIGNAL_SAMPLES];
+  uint8_t             _head;  // where the next sample goes
+  uint8_t             _count;
+};
+
+#endif  // SRC_TINYGSMSIGNAL_H_
@@ -14,11 +14,47 @@
 #define TINY_GSM_MODEM_HAS_TCP
 
 #include "TinyGsmFifo.h"
+#include "TinyGsmHex.h"
+#include "TinyGsmThread.h"
 
 #if !defined(TINY_GSM_RX_BUFFER)
 #define TINY_GSM_RX_BUFFER 64
 #endif
 
+// // Fill the receive buffers from an ISR or another thread while the
+// // application drains them; TINY_GSM_RX_BUFFER must be a power of two
+// #define TINY_GSM_RX_SPSC
+
+// Time written data may wait in a client's transmit buffer for more to join it
+#if !defined(TINY_GSM_TX_IDLE_MS)
+#define TINY_GSM_TX_IDLE_MS 20
+#endif
+
+// Most asked of the modem in one read straight into the caller's buffer.
+// Modems refuse reads past their own limit, 1024 bytes for the smallest.
+#if !defined(TINY_GSM_RX_DIRECT_MAX)
+#define TINY_GSM_RX_DIRECT_MAX 1024
+#endif
+
+// Hex digits decoded per step with TINY_GSM_USE_HEX; taken from the stack
+#if !defined(TINY_GSM_HEX_CHUNK)
+#define TINY_GSM_HEX_CHUNK 64
+#endif
+
+// Silence the modems that leave transparent mode on "+++" want on either
+// side of it
+#if !defined(TINY_GSM_ESCAPE_GUARD_MS)
+#define TINY_GSM_ESCAPE_GUARD_MS 1000
+#endif
+
+// How often a socket is asked for data the modem did not announce, with
+// TINY_GSM_BUFFER_READ_AND_CHECK_SIZE: every TINY_GSM_POLL_MIN_MS once data
+// was seen, doubling on each empty poll up to TINY_GSM_POLL_MAX_MS.  Unless
+// defined, they are the driver's pollMinMsImpl() and pollMaxMsImpl(), 100 ms
+// and 5 s but for modems that announce data reliably.
+// #define TINY_GSM_POLL_MIN_MS 100
+// #define TINY_GSM_POLL_MAX_MS 5000
+
 // Because of the ordering of resolution of overrides in templates, these need
 // to be written out every time.  This macro is to shorten that.
 #define TINY_GSM_CLIENT_CONNECT_OVERRIDES                             \
@@ -48,9 +84,49 @@ class TinyGsmTCP {
    * Basic functions
    */
   void maintain() {
+    TINY_GSM_MODEM_LOCK();
+    // In a data mode a command would cost the connection the guard times of
+    // +++, so nothing is asked in the background until the app leaves it
+    if (thisModem().inDataModeImpl()) { return; }
+    // Send the writes nothing has joined for a while
+    for (int mux = 0; mux < muxCount; mux++) {
+      GsmClient* sock = thisModem().sockets[mux];
+      if (sock && sock->tx_len &&
+          millis() - sock->tx_last >= TINY_GSM_TX_IDLE_MS) {
+        sock->flushTx();
+      }
+    }
+    thisModem().maintainSignal();
     return thisModem().maintainImpl();
   }
 
+  // Polls made only in case the modem did not announce data, and how many
+  // of them found some: a high share means its data URCs are unreliable
+  uint32_t getPollCount() const {
+    return polls;
+  }
+  uint32_t getPollHits() const {
+    return poll_hits;
+  }
+
+#if defined TINY_GSM_THREADED
+  // Starts a task that from then on does all the reading from the modem:
+  // every interval_ms it advances the background requests, handles URCs and
+  // moves what arrived on each socket into its client.  Clients then read
+  // from their own buffer only, and never wait for each other or for the
+  // modem to do so.
+  bool startReader(uint32_t interval_ms = 10) {
+    return reader.start(readerLoop, this, interval_ms, "TinyGsmReader");
+  }
+  // Returns once the reader is done with the modem
+  void stopReader() {
+    reader.stop();
+  }
+  bool readerRunning() const {
+    return reader.running();
+  }
+#endif
+
   /*
    * CRTP Helper
    */
@@ -69,9 +145,27 @@ class TinyGsmTCP {
   class GsmClient : public Client {
     // Make all classes created from the modem template friends
     friend class TinyGsmTCP<modemType, muxCount>;
+#if defined TINY_GSM_RX_SPSC
+    typedef TinyGsmSpscFifo<uint8_t, TINY_GSM_RX_BUFFER> RxFifo;
+#else
     typedef TinyGsmFifo<uint8_t, TINY_GSM_RX_BUFFER> RxFifo;
+#endif
+    // For what available() reads without the command lock while the reader
+    // task changes it: sock_available and tx_len
+    typedef TinyGsmShared<uint16_t> Shared16;
 
    public:
+    GsmClient()
+        : rx_direct(NULL),
+          rx_direct_len(0),
+          tx_buf(NULL),
+          tx_cap(0),
+          tx_len(0),
+          tx_last(0),
+          poll_interval(pollMinMs()),
+          poll_forced(false),
+          rx_lost(0) {}
+
     // bool init(modemType* modem, uint8_t);
     // int connect(const char* host, uint16_t port, int timeout_s);
 
@@ -101,6 +195,26 @@ class TinyGsmTCP {
       return host;
     }
 
+    // Gives this client a receive buffer of its own in place of the built-in
+    // TINY_GSM_RX_BUFFER bytes, e.g. a few KB for a bulk transfer while the
+    // control sockets stay small.  The buffer must outlive the client; pass
+    // NULL to go back to the built-in one.  Drops anything not yet read.
+    void setRxBuffer(uint8_t* buf, size_t len) {
+      rx.attach(buf, len);
+    }
+
+    // Gives this client a transmit buffer, so that small writes are sent
+    // together in one modem send instead of one each.  The buffer goes out
+    // when full, once nothing was added for TINY_GSM_TX_IDLE_MS, on flush(),
+    // before reading and before stop().  Size it to at most the modem's
+    // largest send (1460 bytes on most modules); more than 65535 bytes are
+    // not used.  Pass NULL to turn it off.
+    void setTxBuffer(uint8_t* buf, size_t len) {
+      endTx();
+      tx_buf = buf;
+      tx_cap = buf ? TinyGsmMin(len, static_cast<size_t>(0xFFFF)) : 0;
+    }
+
     // void stop(uint32_t maxWaitMs);
     // void stop() override {
     //   stop(15000L);
@@ -108,9 +222,27 @@ class TinyGsmTCP {
 
     // Writes data out on the client using the modem send functionality
     size_t write(const uint8_t* buf, size_t size) override {
+      TINY_GSM_LOCK(at->commandLock());
       TINY_GSM_YIELD();
       at->maintain();
-      return at->modemSend(buf, size, mux);
+      if (!tx_cap) { return at->modemSend(buf, size, mux); }
+      size_t done = 0;
+      while (done < size) {
+        if (!tx_len && size - done >= tx_cap) {
+          // Too big to gain anything from the buffer
+          return done + at->modemSend(buf + done, size - done, mux);
+        }
+        size_t n = TinyGsmMin(size - done,
+                              static_cast<size_t>(tx_cap - tx_len));
+        memcpy(tx_buf + tx_len, buf + done, n);
+        tx_len += n;
+        done += n;
+        tx_last = millis();
+        // What the modem does not take stays buffered; when that leaves no
+        // room, the rest of buf is not written
+        if (tx_len == tx_cap && flushTx() == tx_cap) { break; }
+      }
+      return done;
     }
 
     size_t write(uint8_t c) override {
@@ -123,7 +255,12 @@ class TinyGsmTCP {
     }
 
     int available() override {
+#if defined TINY_GSM_THREADED
+      if (at->readerRunning() && !tx_len) { return readerAvailable(); }
+      TINY_GSM_LOCK(at->commandLock());
+#endif
       TINY_GSM_YIELD();
+      flushTx();
 #if defined TINY_GSM_NO_MODEM_BUFFER
       // Returns the number of characters available in the TinyGSM fifo
       if (!rx.size() && sock_connected) { at->maintain(); }
@@ -140,10 +277,7 @@ class TinyGsmTCP {
       // fifo and the modem chips internal fifo, doing an extra check-in
       // with the modem to see if anything has arrived without a UURC.
       if (!rx.size()) {
-        if (millis() - prev_check > 500) {
-          got_data   = true;
-          prev_check = millis();
-        }
+        pollIfDue();
         at->maintain();
       }
       return static_cast<uint16_t>(rx.size()) + sock_available;
@@ -154,7 +288,18 @@ class TinyGsmTCP {
     }
 
     int read(uint8_t* buf, size_t size) override {
+#if defined TINY_GSM_THREADED
+      if (at->readerRunning()) {
+        if (tx_len) {
+          TINY_GSM_LOCK(at->commandLock());
+          flushTx();
+        }
+        return rx.get(buf, TinyGsmMin(size, rx.size()));
+      }
+      TINY_GSM_LOCK(at->commandLock());
+#endif
       TINY_GSM_YIELD();
+      flushTx();
       size_t cnt = 0;
 
 #if defined TINY_GSM_NO_MODEM_BUFFER
@@ -184,10 +329,16 @@ class TinyGsmTCP {
           buf += chunk;
           cnt += chunk;
           continue;
-        } /* TODO: Read directly into user buffer? */
+        }
         at->maintain();
-        if (sock_available > 0) {
-          int n = at->modemRead(TinyGsmMin((uint16_t)rx.free(), sock_available),
+        if (sock_available > 0 && size - cnt > static_cast<size_t>(rx.free())) {
+          // More wanted than the FIFO holds, so read straight into buf
+          size_t n = modemReadDirect(buf, size - cnt);
+          if (n == 0 && !rx.size()) break;
+          buf += n;
+          cnt += n;
+        } else if (sock_available > 0) {
+          int n = at->modemRead(TinyGsmMin((uint16_t)rx.free(), (uint16_t)sock_available),
                                 mux);
           if (n == 0) break;
         } else {
@@ -209,15 +360,16 @@ class TinyGsmTCP {
           cnt += chunk;
           continue;
         }
-        // Workaround: Some modules "forget" to notify about data arrival
-        if (millis() - prev_check > 500) {
-          got_data   = true;
-          prev_check = millis();
-        }
-        // TODO(vshymanskyy): Read directly into user buffer?
+        pollIfDue();
         at->maintain();
-        if (sock_available > 0) {
-          int n = at->modemRead(TinyGsmMin((uint16_t)rx.free(), sock_available),
+        if (sock_available > 0 && size - cnt > static_cast<size_t>(rx.free())) {
+          // More wanted than the FIFO holds, so read straight into buf
+          size_t n = modemReadDirect(buf, size - cnt);
+          if (n == 0 && !rx.size()) break;
+          buf += n;
+          cnt += n;
+        } else if (sock_available > 0) {
+          int n = at->modemRead(TinyGsmMin((uint16_t)rx.free(), (uint16_t)sock_available),
                                 mux);
           if (n == 0) break;
         } else {
@@ -243,6 +395,8 @@ class TinyGsmTCP {
     }
 
     void flush() override {
+      TINY_GSM_LOCK(at->commandLock());
+      flushTx();
       at->stream.flush();
     }
 
@@ -260,6 +414,7 @@ class TinyGsmTCP {
       // If the modem doesn't have an internal buffer, or if we can't check how
       // many characters are in the buffer then the cascade won't happen.
       // We need to call modemGetConnected to check the sock state.
+      TINY_GSM_LOCK(at->commandLock());
       return at->modemGetConnected(mux);
 #else
 #error Modem client has been incorrectly created
@@ -275,7 +430,63 @@ class TinyGsmTCP {
 
     String remoteIP() TINY_GSM_ATTR_NOT_IMPLEMENTED;
 
+    // Bytes that came for the client while its receive buffer was full, and
+    // were lost: only where the modem does not hold them until asked, as in
+    // a transparent connection, a bulk session or direct push
+    uint32_t getRxLost() const {
+      return rx_lost;
+    }
+
    protected:
+#if defined TINY_GSM_THREADED
+    // What available() gives while the reader fills the client
+    int readerAvailable() {
+#if defined TINY_GSM_NO_MODEM_BUFFER
+      return rx.size();
+#else
+      return static_cast<uint16_t>(rx.size()) + sock_available;
+#endif
+    }
+#endif
+
+    // Sends what the transmit buffer holds.  What the modem does not take
+    // stays in it for the next try, unless the connection is gone; returns
+    // how many bytes stay, 0 if all went out.
+    size_t flushTx() {
+      size_t sent = 0;
+      while (sent < tx_len && sock_connected) {
+        size_t n = at->modemSend(tx_buf + sent, tx_len - sent, mux);
+        if (!n) break;
+        sent += n;
+      }
+      size_t left = sock_connected ? tx_len - sent : 0;
+      if (sent && left) { memmove(tx_buf, tx_buf + sent, left); }
+      tx_len = left;
+      if (left) { tx_last = millis(); }  // tried again once idle
+      return left;
+    }
+
+    // Sends what the transmit buffer holds one last time, before the
+    // connection closes or the buffer changes; the rest is dropped
+    void endTx() {
+      flushTx();
+      tx_len = 0;
+    }
+
+    // Asks the modem for up to len characters and has the payload land in dst
+    // instead of the FIFO.  Returns how many did; any excess goes to rx.
+    size_t modemReadDirect(uint8_t* dst, size_t len) {
+      rx_direct     = dst;
+      rx_direct_len = TinyGsmMin(
+          TinyGsmMin(len, static_cast<size_t>(TINY_GSM_RX_DIRECT_MAX)),
+          static_cast<size_t>(sock_available));
+      at->modemRead(rx_direct_len, mux);
+      size_t n      = rx_direct - dst;
+      rx_direct     = NULL;
+      rx_direct_len = 0;
+      return n;
+    }
+
     // Read and dump anything remaining in the modem's internal buffer.
     // Using this in the client stop() function.
     // The socket will appear open in response to connected() even after it
@@ -289,7 +500,7 @@ class TinyGsmTCP {
       uint32_t startMillis = millis();
       while (sock_available > 0 && (millis() - startMillis < maxWaitMs)) {
         rx.clear();
-        at->modemRead(TinyGsmMin((uint16_t)rx.free(), sock_available), mux);
+        at->modemRead(TinyGsmMin((uint16_t)rx.free(), (uint16_t)sock_available), mux);
       }
       rx.clear();
       at->streamClear();
@@ -303,23 +514,117 @@ class TinyGsmTCP {
 #endif
     }
 
+    // Workaround: Some modules "forget" to notify about data arrival, so ask
+    // once the poll interval has passed since the last time.  Data already
+    // known of is read, and the read tells what is left.
+    void pollIfDue() {
+      if (sock_available) { prev_check = millis(); }
+      if (millis() - prev_check <= poll_interval) { return; }
+      poll_forced = !got_data;
+      got_data    = true;
+      prev_check  = millis();
+    }
+
     modemType* at;
     uint8_t    mux;
-    uint16_t   sock_available;
+    Shared16   sock_available;
     uint32_t   prev_check;
     bool       sock_connected;
     bool       got_data;
     RxFifo     rx;
+    uint8_t*   rx_direct;  // where the payload of modemReadDirect() goes
+    size_t     rx_direct_len;
+    uint8_t*   tx_buf;
+    uint16_t   tx_cap;
+    Shared16   tx_len;
+    uint32_t   tx_last;  // when the last write was buffered
+    uint16_t   poll_interval;
+    bool       poll_forced;  // asked by pollIfDue() alone
+    uint32_t   rx_lost;      // see getRxLost()
   };
 
   /*
    * Basic functions
    */
  protected:
+  // The poll period bounds of the driver (see TINY_GSM_POLL_MIN_MS)
+  static constexpr uint16_t pollMinMsImpl() {
+    return 100;
+  }
+  static constexpr uint16_t pollMaxMsImpl() {
+    return 5000;
+  }
+
+  static constexpr uint16_t pollMinMs() {
+#if defined(TINY_GSM_POLL_MIN_MS)
+    return TINY_GSM_POLL_MIN_MS;
+#else
+    return modemType::pollMinMsImpl();
+#endif
+  }
+  static constexpr uint16_t pollMaxMs() {
+#if defined(TINY_GSM_POLL_MAX_MS)
+    return TINY_GSM_POLL_MAX_MS;
+#else
+    return modemType::pollMaxMsImpl();
+#endif
+  }
+
   void maintainImpl() {
 #if defined TINY_GSM_BUFFER_READ_AND_CHECK_SIZE
-    // Keep listening for modem URC's and proactively iterate through
-    // sockets asking if any data is avaiable
+    // Keep listening for modem URC's and proactively ask the modem if any
+    // data is avaiable for the sockets that want it
+    if (anyGotData()) { refreshSockets(); }
+    thisModem().takeUrcs();
+
+#elif defined TINY_GSM_NO_MODEM_BUFFER || defined TINY_GSM_BUFFER_READ_NO_CHECK
+    // Just listen for any URC's
+    thisModem().waitResponse(100, NULL, NULL);
+
+#else
+#error Modem client has been incorrectly created
+#endif
+  }
+
+#if defined TINY_GSM_BUFFER_READ_AND_CHECK_SIZE
+  bool anyGotData() {
+    for (int mux = 0; mux < muxCount; mux++) {
+      GsmClient* sock = thisModem().sockets[mux];
+      if (sock && sock->got_data) { return true; }
+    }
+    return false;
+  }
+
+  void refreshSockets() {
+    static_assert(pollMinMs() > 0 && pollMinMs() <= pollMaxMs() &&
+                      pollMaxMs() <= 60000L,
+                  "TINY_GSM_POLL_MIN_MS must be within "
+                  "1..TINY_GSM_POLL_MAX_MS, and TINY_GSM_POLL_MAX_MS at most "
+                  "60000");
+    thisModem().modemGetAvailableAll();
+    // Data seen puts a socket back to fast polling, while a poll made only in
+    // case that found nothing doubles the wait for the next one
+    for (int mux = 0; mux < muxCount; mux++) {
+      GsmClient* sock = thisModem().sockets[mux];
+      if (!sock) { continue; }
+      if (sock->poll_forced) {
+        polls++;
+        if (sock->sock_available) { poll_hits++; }
+      }
+      if (sock->sock_available) {
+        sock->poll_interval = pollMinMs();
+      } else if (sock->poll_forced) {
+        sock->poll_interval = TinyGsmMin(2UL * sock->poll_interval,
+                                         (unsigned long)pollMaxMs());
+      }
+      sock->poll_forced = false;
+    }
+  }
+
+  // Refreshes sock_available (and, through it, sock_connected) of the sockets
+  // that want it, one query per socket.  A modem that lists every socket in
+  // one response overrides this to refresh them all from that one query.
+  void modemGetAvailableAll() {
     for (int mux = 0; mux < muxCount; mux++) {
       GsmClient* sock = thisModem().sockets[mux];
       if (sock && sock->got_data) {
@@ -327,34 +632,233 @@ class TinyGsmTCP {
         sock->sock_available = thisModem().modemGetAvailable(mux);
       }
     }
-    while (thisModem().stream.available()) {
-      thisModem().waitResponse(15, NULL, NULL);
-    }
+  }
+#endif
 
-#elif defined TINY_GSM_NO_MODEM_BUFFER || defined TINY_GSM_BUFFER_READ_NO_CHECK
-    // Just listen for any URC's
-    thisModem().waitResponse(100, NULL, NULL);
+#if defined TINY_GSM_THREADED
+  /*
+   * Reader task
+   */
+  static void readerLoop(void* arg) {
+    static_cast<TinyGsmTCP*>(arg)->readerStep();
+  }
 
-#else
-#error Modem client has been incorrectly created
+  // One round of the reader, all of it under the command lock.  Unlike
+  // maintain() it does not listen for URCs that have not started to arrive.
+  void readerStep() {
+    TINY_GSM_MODEM_LOCK();
+    thisModem().poll();
+    if (thisModem().inDataModeImpl()) { return; }  // as in maintain()
+    thisModem().maintainSignal();
+    for (int mux = 0; mux < muxCount; mux++) {
+      GsmClient* sock = thisModem().sockets[mux];
+      if (!sock) { continue; }
+      if (sock->tx_len && millis() - sock->tx_last >= TINY_GSM_TX_IDLE_MS) {
+        sock->flushTx();
+      }
+#if defined TINY_GSM_BUFFER_READ_AND_CHECK_SIZE
+      if (sock->sock_connected) { sock->pollIfDue(); }
+#endif
+    }
+#if defined TINY_GSM_BUFFER_READ_AND_CHECK_SIZE
+    if (anyGotData()) { refreshSockets(); }
+#endif
+    thisModem().takeUrcs();
+#if defined TINY_GSM_BUFFER_READ_AND_CHECK_SIZE || \
+    defined TINY_GSM_BUFFER_READ_NO_CHECK
+    // Fetch what the modem holds for each client (without a modem buffer,
+    // the data came along with its URC above)
+    for (int mux = 0; mux < muxCount; mux++) {
+      GsmClient* sock = thisModem().sockets[mux];
+      if (sock && sock->sock_available > 0 && sock->rx.free() > 0) {
+        thisModem().modemRead(
+            TinyGsmMin(static_cast<uint16_t>(sock->rx.free()),
+                       static_cast<uint16_t>(sock->sock_available)),
+            mux);
+      }
+    }
 #endif
   }
 
-  // Yields up to a time-out period and then reads a character from the stream
-  // into the mux FIFO
-  // TODO(SRGDamia1):  Do we need to wait two _timeout periods for no
-  // character return?  Will wait once in the first "while
-  // !stream.available()" and then will wait again in the stream.read()
-  // function.
-  inline void moveCharFromStreamToFifo(uint8_t mux) {
-    if (!thisModem().sockets[mux]) return;
+  TinyGsmThread reader;
+#endif
+  uint32_t polls     = 0;
+  uint32_t poll_hits = 0;
+
+  // Moves a payload of len characters from the stream into the mux FIFO,
+  // reading whatever the stream has ready straight into the free spans of the
+  // FIFO, or into the caller's buffer during modemReadDirect().  Characters
+  // that do not fit are read and dropped.  Gives up when nothing arrives for a
+  // _timeout period.  Returns the number stored.
+  inline size_t moveCharsFromStreamToFifo(uint8_t mux, size_t len) {
+    GsmClient* sock = thisModem().sockets[mux];
+    if (!sock) return 0;
+    Stream&  stream      = thisModem().stream;
+    size_t   stored      = 0;
     uint32_t startMillis = millis();
-    while (!thisModem().stream.available() &&
-           (millis() - startMillis < thisModem().sockets[mux]->_timeout)) {
-      TINY_GSM_YIELD();
+    while (len > 0 && millis() - startMillis < sock->_timeout) {
+      int ready = stream.available();
+      if (ready <= 0) {
+        TINY_GSM_YIELD();
+        continue;
+      }
+      size_t   chunk = TinyGsmMin(len, static_cast<size_t>(ready));
+      uint8_t* span1;
+      uint8_t* span2;
+      int      room1;
+      int      room2;
+      if (sock->rx_direct_len) {
+        chunk = TinyGsmMin(chunk, sock->rx_direct_len);
+        stream.readBytes(sock->rx_direct, chunk);
+        sock->rx_direct += chunk;
+        sock->rx_direct_len -= chunk;
+        stored += chunk;
+      } else if (sock->rx.writeSpans(&span1, &room1, &span2, &room2) > 0) {
+        size_t n1 = TinyGsmMin(chunk, static_cast<size_t>(room1));
+        size_t n2 = TinyGsmMin(chunk - n1, static_cast<size_t>(room2));
+        stream.readBytes(span1, n1);
+        if (n2) { stream.readBytes(span2, n2); }
+        sock->rx.commit(n1 + n2);
+        chunk = n1 + n2;
+        stored += chunk;
+      } else {
+        for (size_t i = 0; i < chunk; i++) { stream.read(); }
+      }
+      len -= chunk;
+      startMillis = millis();
+    }
+    return stored;
+  }
+
+  // Moves a payload of len characters sent as 2 * len hex digits from the
+  // stream into the mux FIFO, decoding a chunk at a time.  Otherwise the same
+  // as moveCharsFromStreamToFifo().
+  inline size_t moveHexFromStreamToFifo(uint8_t mux, size_t len) {
+    GsmClient* sock = thisModem().sockets[mux];
+    if (!sock) return 0;
+    Stream&  stream      = thisModem().stream;
+    char     hex[TINY_GSM_HEX_CHUNK];
+    uint8_t* bytes       = reinterpret_cast<uint8_t*>(hex);
+    size_t   stored      = 0;
+    uint32_t startMillis = millis();
+    while (len > 0 && millis() - startMillis < sock->_timeout) {
+      int ready = stream.available();
+      if (ready < 2) {
+        TINY_GSM_YIELD();
+        continue;
+      }
+      size_t chunk = TinyGsmMin(len, static_cast<size_t>(ready) / 2);
+      chunk        = TinyGsmMin(chunk, sizeof(hex) / 2);
+      stream.readBytes(hex, 2 * chunk);
+      TinyGsmHexDecode(bytes, hex, chunk);
+      stored += putCharsToFifo(sock, bytes, chunk);
+      len -= chunk;
+      startMillis = millis();
+    }
+    return stored;
+  }
+
+  // Stores decoded payload characters where moveCharsFromStreamToFifo() would
+  // have read them to, dropping what does not fit
+  inline size_t putCharsToFifo(GsmClient* sock, const uint8_t* p, size_t n) {
+    size_t direct = TinyGsmMin(n, sock->rx_direct_len);
+    if (direct) {
+      memcpy(sock->rx_direct, p, direct);
+      sock->rx_direct += direct;
+      sock->rx_direct_len -= direct;
+    }
+    return direct + sock->rx.put(p + direct, n - direct);
+  }
+
+  /*
+   * Quectel URCs
+   */
+  // Reads the rest of a +QIURC report of the Quectel stack, for the driver's
+  // URC handler.  "recv" has data waiting for a connection, or in direct push
+  // mode ",<length>" and the data itself, which goes to modemTakePush(), or
+  // is dropped when no client has the connection.  "closed" ends one.
+  bool takeQiUrc() {
+    modemType& modem = thisModem();
+    modem.streamSkipUntil('\"');
+    String urc = modem.stream.readStringUntil('\"');
+    modem.streamSkipUntil(',');
+    if (urc == "recv") {
+      String     args  = modem.stream.readStringUntil('\n');
+      int8_t     mux   = args.toInt();
+      int        comma = args.indexOf(',');
+      int16_t    len   = comma < 0 ? 0 : args.substring(comma + 1).toInt();
+      GsmClient* sock  = NULL;
+      if (mux >= 0 && mux < muxCount) { sock = modem.sockets[mux]; }
+      DBG("### URC RECV:", mux, len);
+      if (len > 0 && sock) {
+        modem.modemTakePush(mux, len);
+      } else if (len > 0) {
+        DBG("### Push for no client:", len, "bytes dropped");
+        uint32_t startMillis = millis();
+        while (len > 0 && millis() - startMillis < 1000L) {
+          if (modem.stream.read() < 0) {
+            TINY_GSM_YIELD();
+            continue;
+          }
+          len--;
+          startMillis = millis();
+        }
+      } else if (sock) {
+        sock->got_data = true;
+      }
+    } else if (urc == "closed") {
+      int8_t mux = modem.streamGetIntBefore('\n');
+      DBG("### URC CLOSE:", mux);
+      if (mux >= 0 && mux < muxCount && modem.sockets[mux]) {
+        modem.sockets[mux]->sock_connected = false;
+      }
+    } else {
+      modem.streamSkipUntil('\n');
+    }
+    return true;
+  }
+
+  /*
+   * Data mode
+   */
+  // In a data mode (a transparent connection, a bulk session) all the modem
+  // sends is data of one connection: takes what has arrived into the
+  // client's receive buffer.  What it has no room for is lost, and counted
+  // in its getRxLost().
+  void takeDataModeBytes(GsmClient* sock) {
+    Stream& stream = thisModem().stream;
+    size_t  lost   = 0;
+    while (stream.available()) {
+      uint8_t c = stream.read();
+      if (!sock || !sock->rx.put(c)) { lost++; }
+    }
+    if (!lost) { return; }
+    DBG("### Data mode overflow:", lost, "bytes lost");
+    if (sock) { sock->rx_lost += lost; }
+  }
+
+  // Takes the modem from a data mode back to commands with +++, which wants
+  // TINY_GSM_ESCAPE_GUARD_MS of silence on either side; what arrives
+  // meanwhile goes to sock.  last_tx is millis() of the last write.  Tries
+  // twice; false if the modem never answered, and may still be in data mode.
+  // The driver must have inDataModeImpl() false while this runs.
+  bool escapeDataMode(GsmClient* sock, uint32_t last_tx) {
+    Stream& stream = thisModem().stream;
+    stream.flush();
+    for (uint8_t attempt = 0; attempt < 2; attempt++) {
+      while (millis() - last_tx <= TINY_GSM_ESCAPE_GUARD_MS) {
+        takeDataModeBytes(sock);
+        TINY_GSM_YIELD();
+      }
+      takeDataModeBytes(sock);
+      stream.write(reinterpret_cast<const uint8_t*>("+++"), 3);
+      stream.flush();
+      last_tx = millis();
+      if (thisModem().waitResponse(TINY_GSM_ESCAPE_GUARD_MS + 1000L) == 1) {
+        return true;
+      }
     }
-    char c = thisModem().stream.read();
-    thisModem().sockets[mux]->rx.put(c);
+    return false;
   }
 };
 
@@ -10,6 +10,7 @@
 #define SRC_TINYGSMTEMPERATURE_H_
 
 #include "TinyGsmCommon.h"
+#include "TinyGsmThread.h"
 
 #define TINY_GSM_MODEM_HAS_TEMPERATURE
 
@@ -20,6 +21,7 @@ class TinyGsmTemperature {
    * Temperature functions
    */
   float getTemperature() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getTemperatureImpl();
   }
 
@@ -0,0 +1,199 @@
+/**
+ * @file       TinyGsmThread.h
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Oct 2026
+ */
+
+#ifndef SRC_TINYGSMTHREAD_H_
+#define SRC_TINYGSMTHREAD_H_
+
+#include "TinyGsmCommon.h"
+
+// // Use one modem from several tasks: every call takes the modem's command
+// // lock, and startReader() hands all reading from the modem to a task of
+// // its own.  Runs on FreeRTOS (e.g. the ESP32), or on std::thread elsewhere.
+// #define TINY_GSM_THREADED
+
+#if defined TINY_GSM_THREADED
+
+// Clients are filled by the reader while the application drains them
+#if !defined TINY_GSM_RX_SPSC
+#define TINY_GSM_RX_SPSC
+#endif
+
+// Stack (in the units xTaskCreate() takes) and priority of the reader task
+#ifndef TINY_GSM_READER_STACK
+#define TINY_GSM_READER_STACK 4096
+#endif
+
+#ifndef TINY_GSM_READER_PRIORITY
+#define TINY_GSM_READER_PRIORITY 1
+#endif
+
+#include <atomic>
+
+#if defined(ESP32) || defined(ESP_PLATFORM)
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#define TINY_GSM_FREERTOS
+#elif defined(INC_FREERTOS_H)
+#include <semphr.h>
+#include <task.h>
+#define TINY_GSM_FREERTOS
+#else
+#include <chrono>
+#include <mutex>
+#include <thread>
+#endif
+
+// A recursive mutex: the task holding it may take it again, so calls made
+// while it is held (e.g. isNetworkConnected() from waitForNetwork()) go on
+class TinyGsmMutex {
+ public:
+#if defined TINY_GSM_FREERTOS
+  TinyGsmMutex() : _handle(xSemaphoreCreateRecursiveMutex()) {}
+  ~TinyGsmMutex() {
+    vSemaphoreDelete(_handle);
+  }
+  void lock() {
+    xSemaphoreTakeRecursive(_handle, portMAX_DELAY);
+  }
+  void unlock() {
+    xSemaphoreGiveRecursive(_handle);
+  }
+
+ private:
+  SemaphoreHandle_t _handle;
+#else
+  TinyGsmMutex() {}
+  void lock() {
+    _mutex.lock();
+  }
+  void unlock() {
+    _mutex.unlock();
+  }
+
+ private:
+  std::recursive_mutex _mutex;
+#endif
+
+  TinyGsmMutex(const TinyGsmMutex&);
+  TinyGsmMutex& operator=(const TinyGsmMutex&);
+};
+
+// Holds a TinyGsmMutex for as long as it is in scope
+class TinyGsmLock {
+ public:
+  explicit TinyGsmLock(TinyGsmMutex& mutex) : _mutex(mutex) {
+    _mutex.lock();
+  }
+  ~TinyGsmLock() {
+    _mutex.unlock();
+  }
+
+ private:
+  TinyGsmMutex& _mutex;
+
+  TinyGsmLock(const TinyGsmLock&);
+  TinyGsmLock& operator=(const TinyGsmLock&);
+};
+
+// Calls body(arg) every interval_ms on a task of its own, until stop()
+class TinyGsmThread {
+ public:
+  typedef void (*Body)(void* arg);
+
+  TinyGsmThread() : _body(NULL), _arg(NULL), _interval_ms(0), _run(false) {}
+  ~TinyGsmThread() {
+    stop();
+  }
+
+  bool start(Body body, void* arg, uint32_t interval_ms, const char* name) {
+    if (_run) { return false; }
+    _body        = body;
+    _arg         = arg;
+    _interval_ms = interval_ms;
+    _run         = true;
+#if defined TINY_GSM_FREERTOS
+    _exited = false;
+    if (xTaskCreate(loop, name, TINY_GSM_READER_STACK, this,
+                    TINY_GSM_READER_PRIORITY, NULL) != pdPASS) {
+      _run = false;
+    }
+#else
+    (void)name;
+    _thread = std::thread(loop, this);
+#endif
+    return _run;
+  }
+
+  // Returns once the task is done with its last call
+  void stop() {
+    if (!_run) { return; }
+    _run = false;
+#if defined TINY_GSM_FREERTOS
+    while (!_exited) { vTaskDelay(1); }
+#else
+    _thread.join();
+#endif
+  }
+
+  bool running() const {
+    return _run;
+  }
+
+ private:
+  static void loop(void* arg) {
+    TinyGsmThread* self = static_cast<TinyGsmThread*>(arg);
+    while (self->_run) {
+      self->_body(self->_arg);
+#if defined TINY_GSM_FREERTOS
+      vTaskDelay(pdMS_TO_TICKS(self->_interval_ms) + 1);
+#else
+      std::this_thread::sleep_for(
+          std::chrono::milliseconds(self->_interval_ms));
+#endif
+    }
+#if defined TINY_GSM_FREERTOS
+    self->_exited = true;
+    vTaskDelete(NULL);
+#endif
+  }
+
+  Body     _body;
+  void*    _arg;
+  uint32_t _interval_ms;
+#if defined TINY_GSM_FREERTOS
+  volatile bool _run;
+  volatile bool _exited;
+#else
+  std::atomic<bool> _run;
+  std::thread       _thread;
+#endif
+
+  TinyGsmThread(const TinyGsmThread&);
+  TinyGsmThread& operator=(const TinyGsmThread&);
+};
+
+// Holds `mutex` to the end of the scope
+#define TINY_GSM_LOCK(mutex) TinyGsmLock tinyGsmLock(mutex)
+
+// A value changed under the command lock and read by another task without
+// it, e.g. what available() gives while the reader runs
+template <class T>
+using TinyGsmShared = std::atomic<T>;
+
+#else
+#define TINY_GSM_LOCK(mutex)
+
+template <class T>
+using TinyGsmShared = T;
+#endif
+
+// Holds the modem's command lock, from the modem and its modules
+#define TINY_GSM_MODEM_LOCK() TINY_GSM_LOCK(thisModem().commandLock())
+
+#endif  // SRC_TINYGSMTHREAD_H_
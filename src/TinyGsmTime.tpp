@@ -10,6 +10,8 @@
 #define SRC_TINYGSMTIME_H_
 
 #include "TinyGsmCommon.h"
+#include "TinyGsmFields.h"
+#include "TinyGsmThread.h"
 
 #define TINY_GSM_MODEM_HAS_TIME
 
@@ -22,10 +24,12 @@ class TinyGsmTime {
    * Time functions
    */
   String getGSMDateTime(TinyGSMDateTimeFormat format) {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getGSMDateTimeImpl(format);
   }
   bool getNetworkTime(int* year, int* month, int* day, int* hour, int* minute,
                       int* second, float* timezone) {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().getNetworkTimeImpl(year, month, day, hour, minute,
                                           second, timezone);
   }
@@ -66,26 +70,18 @@ class TinyGsmTime {
   bool getNetworkTimeImpl(int* year, int* month, int* day, int* hour,
                           int* minute, int* second, float* timezone) {
     thisModem().sendAT(GF("+CCLK?"));
-    if (thisModem().waitResponse(2000L, GF("+CCLK: \"")) != 1) { return false; }
+    if (thisModem().waitResponse(2000L, GF("+CCLK:")) != 1) { return false; }
 
-    int iyear     = 0;
-    int imonth    = 0;
-    int iday      = 0;
-    int ihour     = 0;
-    int imin      = 0;
-    int isec      = 0;
-    int itimezone = 0;
-
-    // Date & Time
-    iyear       = thisModem().streamGetIntBefore('/');
-    imonth      = thisModem().streamGetIntBefore('/');
-    iday        = thisModem().streamGetIntBefore(',');
-    ihour       = thisModem().streamGetIntBefore(':');
-    imin        = thisModem().streamGetIntBefore(':');
-    isec        = thisModem().streamGetIntLength(2);
-    char tzSign = thisModem().stream.read();
-    itimezone   = thisModem().streamGetIntBefore('\n');
-    if (tzSign == '-') { itimezone = itimezone * -1; }
+    // "yy/MM/dd,hh:mm:ss+zz", the time zone in quarters of an hour
+    TinyGsmFields fields;
+    thisModem().streamGetFields(fields);
+    int iyear     = fields.number(0, 0, 0);
+    int imonth    = fields.number(0, 1, 0);
+    int iday      = fields.number(0, 2, 0);
+    int ihour     = fields.number(0, 3, 0);
+    int imin      = fields.number(0, 4, 0);
+    int isec      = fields.number(0, 5, 0);
+    int itimezone = fields.number(0, 6, 0);
 
     // Set pointers
     if (iyear < 2000) iyear += 2000;
@@ -10,6 +10,7 @@
 #define SRC_TINYGSMWIFI_H_
 
 #include "TinyGsmCommon.h"
+#include "TinyGsmThread.h"
 
 #define TINY_GSM_MODEM_HAS_WIFI
 
@@ -20,9 +21,11 @@ class TinyGsmWifi {
    * WiFi functions
    */
   bool networkConnect(const char* ssid, const char* pwd) {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().networkConnectImpl(ssid, pwd);
   }
   bool networkDisconnect() {
+    TINY_GSM_MODEM_LOCK();
     return thisModem().networkDisconnectImpl();
   }
 
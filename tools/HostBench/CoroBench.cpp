@@ -0,0 +1,216 @@
+/**
+ * @file       CoroBench.cpp
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Oct 2026
+ *
+ * Runs concurrent flows on one BG96 through TinyGsmExecutor, to find how many
+ * a modem sustains.  Each telemetry flow opens its own socket, reads the
+ * server's greeting and then writes a message every period; next to them an
+ * alert flow sends an SMS every few seconds and a housekeeping flow checks
+ * the signal quality every second.  For 1, 2, 4, 8 and 12 telemetry flows it
+ * reports:
+ *   - messages delivered out of those offered, and messages per second
+ *   - average and worst latency, from when a message was due to when the
+ *     modem took it
+ *   - host CPU time per message
+ *   - whether the modem kept up (95% of the messages delivered)
+ *
+ * Needs C++20 (-std=gnu++20).
+ */
+
+#define TINY_GSM_MODEM_BG96
+#define TINY_GSM_CORO_TASKS 16
+
+#include <TinyGsmClient.h>
+#include <TinyGsmCoroutine.h>
+
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "ModemEmulator.h"
+
+static const char greeting[] = "HostBench telemetry sink ready\r\n";
+
+static uint64_t cpuNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+struct Run {
+  TinyGsm*                  modem;
+  TinyGsmExecutor<TinyGsm>* exec;
+  uint32_t                  period_ms;
+  size_t                    msg_len;
+  uint32_t                  end;  // millis() when the flows stop
+  bool                      online;
+
+  uint32_t offered;
+  uint32_t delivered;
+  uint32_t failed;
+  uint64_t latency_ns;
+  uint64_t latency_max_ns;
+  uint32_t sms;
+};
+
+// Sleeps until `due`, but not past the end of the run
+static TinyGsmSleep sleepUntil(Run& run, uint32_t due) {
+  uint32_t now   = millis();
+  uint32_t until = due < run.end ? due : run.end;
+  return run.exec->sleep(until > now ? until - now : 0);
+}
+
+static TinyGsmTask bringUp(Run& run) {
+  bool ok = co_await run.exec->waitForNetwork();
+  if (ok) { run.online = co_await run.exec->gprsConnect("internet"); }
+}
+
+static TinyGsmTask telemetry(Run& run, TinyGsmClient& client) {
+  while (!run.online && millis() < run.end) {
+    co_await run.exec->sleep(10);
+  }
+  if (!run.online) { co_return; }
+  bool connected = co_await run.exec->connect(client, "10.0.0.1", 80);
+  if (!connected) {
+    run.failed++;
+    co_return;
+  }
+  uint8_t hello[sizeof(greeting)];
+  co_await run.exec->read(client, hello, sizeof(hello) - 1, 5000);
+
+  uint8_t msg[1460];
+  memset(msg, 'T', sizeof(msg));
+  // A flow that falls behind still owes every message that came due
+  uint32_t start = millis();
+  if (start < run.end) {
+    run.offered += (run.end - start + run.period_ms - 1) / run.period_ms;
+  }
+  uint32_t due = start;
+  while (due < run.end) {
+    co_await sleepUntil(run, due);
+    if (millis() >= run.end) { break; }
+    uint64_t due_ns = static_cast<uint64_t>(due) * 1000000ULL;
+    size_t   sent   = co_await run.exec->write(client, msg, run.msg_len);
+    if (sent != run.msg_len) {
+      run.failed++;
+      break;
+    }
+    uint64_t now_ns = hostClockNs();
+    uint64_t lat    = now_ns > due_ns ? now_ns - due_ns : 0;
+    run.delivered++;
+    run.latency_ns += lat;
+    if (lat > run.latency_max_ns) { run.latency_max_ns = lat; }
+    due += run.period_ms;
+  }
+}
+
+static TinyGsmTask alerts(Run& run) {
+  uint32_t due = millis() + 1000;
+  while (millis() < run.end) {
+    co_await sleepUntil(run, due);
+    if (millis() >= run.end) { break; }
+    bool sent = co_await run.exec->sendSMS("+380000000000", "Telemetry alert");
+    if (sent) { run.sms++; }
+    due += 2000;
+  }
+}
+
+static TinyGsmTask housekeeping(Run& run) {
+  uint32_t due = millis() + 500;
+  while (millis() < run.end) {
+    co_await sleepUntil(run, due);
+    if (millis() >= run.end) { break; }
+    co_await run.exec->call(
+        [&run]() { return run.modem->getSignalQuality(); });
+    due += 1000;
+  }
+}
+
+static bool bench(uint8_t flows, uint32_t baud, uint32_t latency_us,
+                  uint32_t period_ms, size_t msg_len, uint32_t duration_ms) {
+  ModemEmulator* emu = ModemEmulator::create("BG96", baud);
+  emu->setLatency(latency_us);
+  emu->serve(reinterpret_cast<const uint8_t*>(greeting), sizeof(greeting) - 1);
+
+  TinyGsm modem(*emu);
+  if (!modem.init()) {
+    fprintf(stderr, "modem init failed\n");
+    return false;
+  }
+  TinyGsmExecutor<TinyGsm> exec(modem);
+  TinyGsmClient*           clients[TINY_GSM_MUX_COUNT];
+
+  Run run;
+  memset(&run, 0, sizeof(run));
+  run.modem     = &modem;
+  run.exec      = &exec;
+  run.period_ms = period_ms;
+  run.msg_len   = msg_len;
+  run.end       = millis() + duration_ms;
+
+  exec.spawn(bringUp(run));
+  for (uint8_t i = 0; i < flows; i++) {
+    clients[i] = new TinyGsmClient(modem, i);
+    exec.spawn(telemetry(run, *clients[i]));
+  }
+  exec.spawn(alerts(run));
+  exec.spawn(housekeeping(run));
+
+  uint64_t cpu0 = cpuNs();
+  exec.run();
+  uint64_t cpu = cpuNs() - cpu0;
+
+  bool kept_up = run.delivered * 100ULL >= run.offered * 95ULL;
+  printf("BG96     coro %2u flows  %5u/%5u msg  %7.1f msg/s  "
+         "lat %7.1f avg %8.1f max ms  %6.1f us/msg  %2u SMS  %s\n",
+         flows, run.delivered, run.offered,
+         run.delivered * 1000.0 / duration_ms,
+         run.delivered ? run.latency_ns / 1e6 / run.delivered : 0.0,
+         run.latency_max_ns / 1e6,
+         run.delivered ? cpu / 1e3 / run.delivered : 0.0, run.sms,
+         run.failed ? "FAILED" : kept_up ? "sustained" : "overloaded");
+
+  for (uint8_t i = 0; i < flows; i++) { delete clients[i]; }
+  delete emu;
+  return !run.failed && run.online;
+}
+
+int main(int argc, char** argv) {
+  uint32_t baud        = 115200;
+  uint32_t latency_us  = 5000;
+  uint32_t period_ms   = 250;
+  size_t   msg_len     = 256;
+  uint32_t duration_ms = 5000;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "b:l:p:m:d:")) != -1) {
+    switch (opt) {
+      case 'b': baud = atol(optarg); break;
+      case 'l': latency_us = atol(optarg); break;
+      case 'p': period_ms = atol(optarg); break;
+      case 'm': msg_len = atol(optarg); break;
+      case 'd': duration_ms = atol(optarg); break;
+      default:
+        fprintf(stderr,
+                "usage: %s [-b baud] [-l latency_us] [-p period_ms] "
+                "[-m msg_len] [-d duration_ms]\n",
+                argv[0]);
+        return 2;
+    }
+  }
+  if (!period_ms || !msg_len || msg_len > 1460) {
+    fprintf(stderr, "period must be non-zero and msg_len 1..1460\n");
+    return 2;
+  }
+
+  static const uint8_t sweep[] = {1, 2, 4, 8, 12};
+  bool                 ok      = true;
+  for (uint8_t i = 0; i < sizeof(sweep); i++) {
+    if (sweep[i] > TINY_GSM_MUX_COUNT) { break; }
+    ok &= bench(sweep[i], baud, latency_us, period_ms, msg_len, duration_ms);
+  }
+  return ok ? 0 : 1;
+}
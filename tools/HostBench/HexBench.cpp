@@ -0,0 +1,114 @@
+/**
+ * @file       HexBench.cpp
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Oct 2026
+ *
+ * Decodes a hex-encoded file (as sent by a modem with TINY_GSM_USE_HEX) with
+ * the per-byte strtol() loop the drivers used to run and with
+ * TinyGsmHexDecode(), and reports host CPU time per payload byte for each.
+ */
+
+#include <TinyGsmHex.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <string>
+
+static uint64_t cpuNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static bool loadFile(const char* path, std::string& out) {
+  FILE* f = fopen(path, "rb");
+  if (!f) return false;
+  char   buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.append(buf, n);
+  fclose(f);
+  return true;
+}
+
+// What modemRead() did for every byte before TinyGsmHexDecode()
+static void decodeStrtol(uint8_t* dst, const char* src, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    char buf[4] = {
+        0,
+    };
+    buf[0] = src[2 * i];
+    buf[1] = src[2 * i + 1];
+    dst[i] = strtol(buf, NULL, 16);
+  }
+}
+
+static void decodeBulk(uint8_t* dst, const char* src, size_t n) {
+  TinyGsmHexDecode(dst, src, n);
+}
+
+static void run(const char* what, void (*decode)(uint8_t*, const char*, size_t),
+                const std::string& hex, const std::string& data, size_t chunk,
+                int rounds) {
+  std::string out(data.size(), '\0');
+  uint8_t*    dst = reinterpret_cast<uint8_t*>(&out[0]);
+  uint64_t    t0  = cpuNs();
+  for (int r = 0; r < rounds; r++) {
+    for (size_t i = 0; i < data.size(); i += chunk) {
+      size_t n = data.size() - i < chunk ? data.size() - i : chunk;
+      decode(dst + i, hex.data() + 2 * i, n);
+    }
+  }
+  uint64_t ns = cpuNs() - t0;
+  printf("hex      %-6s %9zu B  chunk %5zu  %8.2f ns/B  %s\n", what,
+         data.size(), chunk, static_cast<double>(ns) / rounds / data.size(),
+         out == data ? "OK" : "MISMATCH");
+}
+
+int main(int argc, char** argv) {
+  const char* file   = "../../extras/test_1m.bin";
+  size_t      chunk  = 32;
+  int         rounds = 5;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "f:c:n:")) != -1) {
+    switch (opt) {
+      case 'f': file = optarg; break;
+      case 'c': chunk = atol(optarg); break;
+      case 'n': rounds = atoi(optarg); break;
+      default:
+        fprintf(stderr, "usage: %s [-f file] [-c chunk] [-n rounds]\n",
+                argv[0]);
+        return 2;
+    }
+  }
+
+  std::string data;
+  if (!loadFile(file, data) || data.empty()) {
+    fprintf(stderr, "cannot read %s\n", file);
+    return 1;
+  }
+  if (!chunk || rounds <= 0) {
+    fprintf(stderr, "chunk and rounds must be positive\n");
+    return 2;
+  }
+
+  // Mixed case, as modems differ in which one they send
+  static const char digits[] = "0123456789ABCDEF0123456789abcdef";
+  std::string       hex;
+  hex.reserve(2 * data.size());
+  for (size_t i = 0; i < data.size(); i++) {
+    uint8_t c    = data[i];
+    size_t  lower = (i & 1) << 4;
+    hex += digits[lower + (c >> 4)];
+    hex += digits[lower + (c & 0x0F)];
+  }
+
+  run("strtol", decodeStrtol, hex, data, chunk, rounds);
+  run("bulk", decodeBulk, hex, data, chunk, rounds);
+  return 0;
+}
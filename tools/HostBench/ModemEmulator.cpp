@@ -0,0 +1,814 @@
+/**
+ * @file       ModemEmulator.cpp
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Oct 2026
+ */
+
+#include "ModemEmulator.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+#include <algorithm>
+
+static bool startsWith(const std::string& s, const char* prefix) {
+  return s.compare(0, strlen(prefix), prefix) == 0;
+}
+
+static std::string itos(long long v) {
+  return String(static_cast<long>(v)).c_str();
+}
+
+/*
+ * Wire
+ */
+
+ModemEmulator::ModemEmulator(uint32_t baud)
+    : commands(0),
+      bytes_in(0),
+      bytes_out(0),
+      tx_window(EMU_TX_WINDOW),
+      // 8N1: ten bit times per character
+      byte_ns(10000000000ULL / baud),
+      latency_ns(5000000ULL),
+      wire_free_ns(0),
+      payload_left(0),
+      payload_mux(0),
+      skip_lf(false),
+      sms_text(false),
+      transparent(false),
+      transparent_mux(0),
+      last_data_ns(0),
+      trace(getenv("EMU_TRACE") != NULL),
+      reg_stat(1),
+      bearer(true),
+      cgerep(false) {
+  for (int i = 0; i < 3; i++) reg_n[i] = 0;
+  for (int i = 0; i < EMU_MUX_COUNT; i++) {
+    sockets[i].open = false;
+    sockets[i].read = 0;
+  }
+}
+
+// Number of bytes that have fully crossed the wire by now
+size_t ModemEmulator::ready() {
+  uint64_t now = hostClockNs();
+  size_t   n   = 0;
+  for (std::deque<Chunk>::iterator it = tx.begin(); it != tx.end(); ++it) {
+    if (now < it->start_ns + byte_ns) break;
+    size_t arrived = std::min<uint64_t>(it->data.size(),
+                                        (now - it->start_ns) / byte_ns);
+    n += arrived - it->pos;
+    if (arrived < it->data.size()) break;
+  }
+  return n;
+}
+
+// Nothing to read yet: idle for one character time, about what a poll of a
+// real UART costs, or less if the next byte comes sooner
+void ModemEmulator::settle() {
+  if (tx.empty() || tx.front().start_ns > hostClockNs()) lineIdle();
+  uint64_t next = hostClockNs() + byte_ns;
+  if (!tx.empty()) {
+    const Chunk& c = tx.front();
+    next           = std::min(next, c.start_ns + (c.pos + 1) * byte_ns);
+  }
+  hostClockAdvanceTo(next);
+}
+
+int ModemEmulator::available() {
+  size_t n = ready();
+  if (!n) {
+    settle();
+    n = ready();
+  }
+  return static_cast<int>(n);
+}
+
+int ModemEmulator::peek() {
+  if (!ready()) settle();
+  if (!ready()) return -1;
+  const Chunk& c = tx.front();
+  return static_cast<uint8_t>(c.data[c.pos]);
+}
+
+int ModemEmulator::read() {
+  if (!ready()) settle();
+  if (!ready()) return -1;
+  Chunk&  c = tx.front();
+  uint8_t b = static_cast<uint8_t>(c.data[c.pos++]);
+  if (c.pos == c.data.size()) tx.pop_front();
+  bytes_out++;
+  return b;
+}
+
+size_t ModemEmulator::readBytes(char* buffer, size_t length) {
+  size_t count = 0;
+  while (count < length) {
+    size_t n = ready();
+    if (!n) {
+      settle();
+      if (!(n = ready())) break;
+    }
+    Chunk& c = tx.front();
+    n        = std::min(n, std::min(length - count, c.data.size() - c.pos));
+    memcpy(buffer + count, c.data.data() + c.pos, n);
+    c.pos += n;
+    count += n;
+    bytes_out += n;
+    if (c.pos == c.data.size()) tx.pop_front();
+  }
+  return count;
+}
+
+size_t ModemEmulator::write(uint8_t c) {
+  hostClockAdvance(byte_ns);
+  bytes_in++;
+  if (skip_lf) {
+    // The "\n" that ends the command line which opened a payload
+    skip_lf = false;
+    if (c == '\n') return 1;
+  }
+  if (sms_text) {
+    // The message body of +CMGS, up to Ctrl-Z (send) or Esc (cancel)
+    if (c == 0x1A || c == 0x1B) {
+      sms_text = false;
+      reply(c == 0x1A ? "\r\n+CMGS: 1\r\n\r\nOK\r\n" : "\r\nOK\r\n");
+    }
+  } else if (transparent) {
+    passThrough(c);
+  } else if (payload_left) {
+    payload += static_cast<char>(c);
+    if (--payload_left == 0) {
+      std::string p;
+      p.swap(payload);
+      handlePayload(payload_mux, p);
+    }
+  } else if (c == '\r') {
+    std::string l;
+    l.swap(line);
+    lineReceived(l);
+  } else if (c != '\n') {
+    line += static_cast<char>(c);
+  }
+  return 1;
+}
+
+size_t ModemEmulator::write(const uint8_t* buf, size_t size) {
+  for (size_t i = 0; i < size; i++) write(buf[i]);
+  return size;
+}
+
+void ModemEmulator::reply(const std::string& s) {
+  queue(s, hostClockNs() + latency_ns);
+}
+
+void ModemEmulator::send(const std::string& s) {
+  uint64_t now = hostClockNs();
+  if (tx.empty() || tx.front().start_ns <= now) {
+    queue(s, now);
+    return;
+  }
+  // The line is free until the next answer, which waits for s if it must
+  if (trace) {
+    fprintf(stderr, "[%10.3f] <- %.60s%s\n", now / 1e9, s.c_str(),
+            s.size() > 60 ? "..." : "");
+  }
+  uint64_t end = now + s.size() * byte_ns;
+  if (end > tx.front().start_ns) {
+    uint64_t shift = end - tx.front().start_ns;
+    for (size_t i = 0; i < tx.size(); i++) tx[i].start_ns += shift;
+    wire_free_ns += shift;
+  }
+  Chunk c;
+  c.start_ns = now;
+  c.data     = s;
+  c.pos      = 0;
+  tx.push_front(c);
+}
+
+void ModemEmulator::queue(const std::string& s, uint64_t start_ns) {
+  if (s.empty()) return;
+  if (trace) {
+    fprintf(stderr, "[%10.3f] <- %.60s%s\n", hostClockNs() / 1e9,
+            s.c_str(), s.size() > 60 ? "..." : "");
+  }
+  Chunk c;
+  c.start_ns   = std::max(start_ns, wire_free_ns);
+  c.data       = s;
+  c.pos        = 0;
+  wire_free_ns = c.start_ns + s.size() * byte_ns;
+  tx.push_back(c);
+}
+
+void ModemEmulator::expectPayload(uint8_t mux, size_t len) {
+  payload_mux  = mux;
+  payload_left = len;
+  skip_lf      = true;
+  payload.clear();
+  payload.reserve(len);
+}
+
+void ModemEmulator::enterTransparent(uint8_t mux) {
+  transparent     = true;
+  transparent_mux = mux;
+  skip_lf         = true;
+  last_data_ns    = hostClockNs();
+  escape.clear();
+}
+
+// A "+++" after a guard time of silence leaves transparent mode; the guard
+// after it is not waited for
+void ModemEmulator::passThrough(uint8_t c) {
+  uint64_t now = hostClockNs();
+  bool     quiet = now - last_data_ns >= EMU_ESCAPE_GUARD_NS;
+  if (c == '+' && (!escape.empty() || quiet)) {
+    escape += '+';
+    if (escape.size() == 3) {
+      transparent = false;
+      escape.clear();
+      ok();
+    }
+    return;
+  }
+  std::string& sink = sockets[transparent_mux].sink;
+  sink += escape;
+  sink += static_cast<char>(c);
+  escape.clear();
+  last_data_ns = now;
+}
+
+/*
+ * Command dispatch
+ */
+
+void ModemEmulator::lineReceived(const std::string& l) {
+  size_t at = 0;
+  while (at < l.size() && isspace(static_cast<unsigned char>(l[at]))) at++;
+  if (l.size() < at + 2 || strncasecmp(l.c_str() + at, "AT", 2) != 0) return;
+  std::string cmd = l.substr(at + 2);
+  commands++;
+  if (trace) fprintf(stderr, "[%10.3f] AT%s\n", hostClockNs() / 1e9, cmd.c_str());
+  if (handleScript(cmd)) return;
+  if (handleCommand(cmd)) return;
+  if (handleCommon(cmd)) return;
+  ok();
+}
+
+bool ModemEmulator::handleScript(const std::string& cmd) {
+  const std::string* best     = NULL;
+  size_t             best_len = 0;
+  for (std::map<std::string, std::string>::const_iterator it = script.begin();
+       it != script.end(); ++it) {
+    if (startsWith(cmd, it->first.c_str()) && it->first.size() >= best_len) {
+      best     = &it->second;
+      best_len = it->first.size();
+    }
+  }
+  if (!best) return false;
+  reply(*best);
+  return true;
+}
+
+bool ModemEmulator::handleCommon(const std::string& cmd) {
+  if (cmd == "+CPIN?") {
+    reply("\r\n+CPIN: READY\r\n\r\nOK\r\n");
+  } else if (cmd == "+CGMI") {
+    reply("\r\nHostBench\r\n\r\nOK\r\n");
+  } else if (regDomain(cmd) >= 0 && cmd[cmd.size() - 1] == '?') {
+    int n = reg_n[regDomain(cmd)];
+    reply("\r\n" + cmd.substr(0, cmd.size() - 1) + ": " + std::to_string(n) +
+          "," + regReport(n) + "\r\n\r\nOK\r\n");
+  } else if (regDomain(cmd) >= 0) {
+    reg_n[regDomain(cmd)] = atoi(cmd.c_str() + cmd.find('=') + 1);
+    ok();
+  } else if (cmd == "+CESQ") {
+    reply("\r\n+CESQ: 99,99,255,255,28,62\r\n\r\nOK\r\n");
+  } else if (cmd == "+CSQ") {
+    reply("\r\n+CSQ: 21,0\r\n\r\nOK\r\n");
+  } else if (cmd == "+CGATT?") {
+    reply(bearer ? "\r\n+CGATT: 1\r\n\r\nOK\r\n"
+                 : "\r\n+CGATT: 0\r\n\r\nOK\r\n");
+  } else if (cmd == "+CGPADDR=1") {
+    reply(bearer ? "\r\n+CGPADDR: 1,10.0.0.2\r\n\r\nOK\r\n"
+                 : "\r\n+CGPADDR: 1,0.0.0.0\r\n\r\nOK\r\n");
+  } else if (startsWith(cmd, "+CGEREP=")) {
+    cgerep = atoi(cmd.c_str() + 8) != 0;
+    ok();
+  } else if (cmd == "+CBC") {
+    reply("\r\n+CBC: 0,85,4012\r\n\r\nOK\r\n");
+  } else if (startsWith(cmd, "+CMGS=")) {
+    reply("\r\n> ");
+    sms_text = true;
+  } else if (cmd == "+CCLK?") {
+    reply("\r\n+CCLK: \"26/10/18,12:00:00+00\"\r\n\r\nOK\r\n");
+  } else {
+    return false;
+  }
+  return true;
+}
+
+int ModemEmulator::regDomain(const std::string& cmd) {
+  static const char* const names[] = {"+CREG", "+CGREG", "+CEREG"};
+  for (int i = 0; i < 3; i++) {
+    size_t len = strlen(names[i]);
+    if (startsWith(cmd, names[i]) && (cmd[len] == '?' || cmd[len] == '=')) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+std::string ModemEmulator::regReport(int n) const {
+  std::string out = std::to_string(reg_stat);
+  if (n >= 2 && (reg_stat == 1 || reg_stat == 5)) {
+    out += ",\"1A2B\",\"01A2B3C4\",7";
+  }
+  return out;
+}
+
+void ModemEmulator::setRegistration(int stat) {
+  static const char* const names[] = {"+CREG", "+CGREG", "+CEREG"};
+  reg_stat = stat;
+  for (int i = 0; i < 3; i++) {
+    if (reg_n[i]) {
+      reply(std::string("\r\n") + names[i] + ": " + regReport(reg_n[i]) +
+            "\r\n");
+    }
+  }
+}
+
+void ModemEmulator::setBearer(bool up) {
+  bearer = up;
+  if (cgerep) {
+    reply(up ? "\r\n+CGEV: NW PDN ACT 1\r\n"
+             : "\r\n+CGEV: NW PDN DEACT 1\r\n");
+  }
+}
+
+void ModemEmulator::on(const char* command, const char* reply) {
+  script[command] = reply;
+}
+
+bool ModemEmulator::loadScript(const char* path) {
+  FILE* f = fopen(path, "r");
+  if (!f) return false;
+  char buf[1024];
+  while (fgets(buf, sizeof(buf), f)) {
+    std::string l(buf);
+    while (!l.empty() && (l[l.size() - 1] == '\n' || l[l.size() - 1] == '\r'))
+      l.erase(l.size() - 1);
+    if (l.empty() || l[0] == '#') continue;
+    size_t tab = l.find('\t');
+    if (tab == std::string::npos) continue;
+    std::string cmd = l.substr(0, tab);
+    if (cmd.size() >= 2 && strncasecmp(cmd.c_str(), "AT", 2) == 0) {
+      cmd = cmd.substr(2);
+    }
+    std::string rep;
+    for (size_t i = tab + 1; i < l.size(); i++) {
+      if (l[i] == '\\' && i + 1 < l.size()) {
+        char e = l[++i];
+        rep += e == 'r' ? '\r' : e == 'n' ? '\n' : e;
+      } else {
+        rep += l[i];
+      }
+    }
+    script[cmd] = rep;
+  }
+  fclose(f);
+  return true;
+}
+
+/*
+ * Sockets
+ */
+
+bool ModemEmulator::openSocket(uint8_t mux) {
+  if (mux >= EMU_MUX_COUNT) return false;
+  Socket& s = sockets[mux];
+  s.open    = true;
+  s.sink.clear();
+  s.source = download;
+  s.read   = 0;
+  return true;
+}
+
+void ModemEmulator::closeSocket(uint8_t mux) {
+  if (mux >= EMU_MUX_COUNT) return;
+  sockets[mux].open = false;
+}
+
+std::string ModemEmulator::take(uint8_t mux, size_t len) {
+  Socket& s = sockets[mux % EMU_MUX_COUNT];
+  len       = std::min(len, unread(mux));
+  std::string out(s.source, s.read, len);
+  s.read += len;
+  return out;
+}
+
+std::vector<std::string> ModemEmulator::split(const std::string& args) {
+  std::vector<std::string> out(1);
+  bool                     quoted = false;
+  for (size_t i = 0; i < args.size(); i++) {
+    char c = args[i];
+    if (c == '"') {
+      quoted = !quoted;
+    } else if (c == ',' && !quoted) {
+      out.push_back(std::string());
+    } else {
+      out.back() += c;
+    }
+  }
+  return out;
+}
+
+long ModemEmulator::num(const std::vector<std::string>& args, size_t index) {
+  return index < args.size() ? atol(args[index].c_str()) : -1;
+}
+
+std::string ModemEmulator::hex(const std::string& data) {
+  static const char digits[] = "0123456789ABCDEF";
+  std::string       out;
+  out.reserve(data.size() * 2);
+  for (size_t i = 0; i < data.size(); i++) {
+    uint8_t b = static_cast<uint8_t>(data[i]);
+    out += digits[b >> 4];
+    out += digits[b & 0x0F];
+  }
+  return out;
+}
+
+/*
+ * SIMCom SIM7000: +CAOPEN / +CASEND / +CARECV
+ */
+
+class EmuSim7000 : public ModemEmulator {
+ public:
+  explicit EmuSim7000(uint32_t baud) : ModemEmulator(baud) {}
+  const char* name() const override {
+    return "SIM7000";
+  }
+
+ protected:
+  bool handleCommand(const std::string& cmd) override {
+    if (cmd == "+GMM") {
+      reply("\r\nSIMCOM_SIM7000G\r\n\r\nOK\r\n");
+    } else if (cmd == "+CNACT?") {
+      reply("\r\n+CNACT: 1,\"10.0.0.2\"\r\n\r\nOK\r\n");
+    } else if (startsWith(cmd, "+CAOPEN=")) {
+      long mux = num(split(cmd.substr(8)), 0);
+      if (!openSocket(mux)) {
+        error();
+        return true;
+      }
+      reply("\r\n+CAOPEN: " + itos(mux) + ",0\r\n\r\nOK\r\n");
+      if (unread(mux)) reply("\r\n+CADATAIND: " + itos(mux) + "\r\n");
+    } else if (startsWith(cmd, "+CASEND=")) {
+      std::vector<std::string> a   = split(cmd.substr(8));
+      long                     mux = num(a, 0);
+      long                     len = num(a, 1);
+      if (mux < 0 || mux >= EMU_MUX_COUNT || !sockets[mux].open || len <= 0 ||
+          len > 1460) {
+        error();
+        return true;
+      }
+      reply("\r\n> ");
+      expectPayload(mux, len);
+    } else if (cmd == "+CARECV?") {
+      std::string r = "\r\n";
+      for (int mux = 0; mux < EMU_MUX_COUNT; mux++) {
+        if (!sockets[mux].open) continue;
+        r += "+CARECV: " + itos(mux) + "," + itos(unread(mux)) + "\r\n";
+      }
+      reply(r + "\r\nOK\r\n");
+    } else if (startsWith(cmd, "+CARECV=")) {
+      std::vector<std::string> a    = split(cmd.substr(8));
+      long                     mux  = num(a, 0);
+      long                     size = num(a, 1);
+      if (mux < 0 || mux >= EMU_MUX_COUNT || size <= 0) {
+        error();
+        return true;
+      }
+      std::string data = take(mux, std::min<long>(size, 1460));
+      if (data.empty()) {
+        reply("\r\n+CARECV: 0\r\n\r\nOK\r\n");
+      } else {
+        reply("\r\n+CARECV: " + itos(data.size()) + "," + data +
+              "\r\n\r\nOK\r\n");
+      }
+    } else if (cmd == "+CASTATE?") {
+      std::string r = "\r\n";
+      for (int mux = 0; mux < EMU_MUX_COUNT; mux++) {
+        if (!sockets[mux].open) continue;
+        r += "+CASTATE: " + itos(mux) + ",1\r\n";
+      }
+      reply(r + "\r\nOK\r\n");
+    } else if (startsWith(cmd, "+CASWITCH=")) {
+      std::vector<std::string> a   = split(cmd.substr(10));
+      long                     mux = num(a, 0);
+      if (mux < 0 || mux >= EMU_MUX_COUNT || !sockets[mux].open ||
+          num(a, 1) != 1) {
+        error();
+      } else {
+        reply("\r\nCONNECT\r\n");
+        enterTransparent(mux);
+      }
+    } else if (startsWith(cmd, "+CACLOSE=")) {
+      closeSocket(num(split(cmd.substr(9)), 0));
+      ok();
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  void handlePayload(uint8_t mux, const std::string& payload) override {
+    sockets[mux].sink += payload;
+    reply("\r\n+CASEND: " + itos(mux) + ",0," + itos(payload.size()) +
+          "\r\n");
+  }
+};
+
+/*
+ * SIMCom SIM800: +CIPSTART / +CIPSEND / +CIPRXGET / +CIPACK
+ */
+
+class EmuSim800 : public ModemEmulator {
+ public:
+  explicit EmuSim800(uint32_t baud)
+      : ModemEmulator(baud), cipmux(true), cipmode(false) {
+    for (int i = 0; i < EMU_MUX_COUNT; i++) failed[i] = false;
+  }
+  const char* name() const override {
+    return "SIM800";
+  }
+
+ protected:
+  bool handleCommand(const std::string& cmd) override {
+    if (cmd == "+GMM") {
+      reply("\r\nSIMCOM_SIM800L\r\n\r\nOK\r\n");
+    } else if (startsWith(cmd, "+CIPMUX=")) {
+      cipmux = num(split(cmd.substr(8)), 0) == 1;
+      ok();
+    } else if (startsWith(cmd, "+CIPMODE=")) {
+      cipmode = num(split(cmd.substr(9)), 0) == 1;
+      ok();
+    } else if (startsWith(cmd, "+CIPSTART=") && !cipmux) {
+      // One connection: in transparent mode the modem sends all it gets
+      openSocket(0);
+      ok();
+      if (!cipmode) {
+        reply("\r\nCONNECT OK\r\n");
+        return true;
+      }
+      reply("\r\nCONNECT\r\n");
+      enterTransparent(0);
+      std::string data;
+      while (unread(0)) data += take(0, unread(0));
+      reply(data);
+    } else if (cmd == "O") {
+      if (cipmode && sockets[0].open) {
+        reply("\r\nCONNECT\r\n");
+        enterTransparent(0);
+      } else {
+        reply("\r\nNO CARRIER\r\n");
+      }
+    } else if (startsWith(cmd, "+CIPCLOSE=") && !cipmux) {
+      closeSocket(0);
+      reply("\r\nCLOSE OK\r\n");
+    } else if (startsWith(cmd, "+CIPSTART=")) {
+      long mux = num(split(cmd.substr(10)), 0);
+      if (!openSocket(mux)) {
+        error();
+        return true;
+      }
+      inflight[mux].clear();
+      failed[mux] = false;
+      ok();
+      reply("\r\n" + itos(mux) + ", CONNECT OK\r\n");
+      if (unread(mux)) reply("\r\n+CIPRXGET: 1," + itos(mux) + "\r\n");
+    } else if (startsWith(cmd, "+CIPSEND=")) {
+      std::vector<std::string> a   = split(cmd.substr(9));
+      long                     mux = num(a, 0);
+      long                     len = num(a, 1);
+      if (mux < 0 || mux >= EMU_MUX_COUNT || !sockets[mux].open || len <= 0 ||
+          len > 1460) {
+        error();
+        return true;
+      }
+      reply("\r\n> ");
+      expectPayload(mux, len);
+    } else if (startsWith(cmd, "+CIPACK=")) {
+      long mux = num(split(cmd.substr(8)), 0);
+      if (mux < 0 || mux >= EMU_MUX_COUNT) {
+        error();
+        return true;
+      }
+      size_t sent = sockets[mux].sink.size();
+      size_t nack = unacked(mux);
+      reply("\r\n+CIPACK: " + itos(sent) + "," + itos(sent - nack) + "," +
+            itos(nack) + "\r\n\r\nOK\r\n");
+    } else if (startsWith(cmd, "+CIPRXGET=")) {
+      std::vector<std::string> a    = split(cmd.substr(10));
+      long                     mode = num(a, 0);
+      long                     mux  = num(a, 1);
+      if (mode == 1) {
+        ok();
+      } else if (mux < 0 || mux >= EMU_MUX_COUNT) {
+        error();
+      } else if (mode == 4) {
+        reply("\r\n+CIPRXGET: 4," + itos(mux) + "," + itos(unread(mux)) +
+              "\r\n\r\nOK\r\n");
+      } else if (mode == 2 || mode == 3) {
+        // In HEX mode each byte takes two characters of the 1460 limit
+        long        limit = mode == 3 ? 730 : 1460;
+        std::string data  = take(mux, std::min(num(a, 2), limit));
+        reply("\r\n+CIPRXGET: " + itos(mode) + "," + itos(mux) + "," +
+              itos(data.size()) + "," + itos(unread(mux)) + "\r\n" +
+              (mode == 3 ? hex(data) : data) + "\r\nOK\r\n");
+      } else {
+        error();
+      }
+    } else if (cmd == "+CIPSTATUS") {
+      std::string r = "\r\nOK\r\n\r\nSTATE: IP PROCESSING\r\n";
+      for (int mux = 0; mux < 6; mux++) {
+        bool up = mux < EMU_MUX_COUNT && sockets[mux].open;
+        r += "\r\nC: " + itos(mux) +
+             (up ? ",0,\"TCP\",\"10.0.0.1\",\"80\",\"CONNECTED\""
+                 : ",,\"\",\"\",\"\",\"INITIAL\"");
+      }
+      reply(r + "\r\n");
+    } else if (startsWith(cmd, "+CIPSTATUS=")) {
+      long mux = num(split(cmd.substr(11)), 0);
+      bool up  = mux >= 0 && mux < EMU_MUX_COUNT && sockets[mux].open;
+      reply("\r\n+CIPSTATUS: " + itos(mux) +
+            ",0,\"TCP\",\"10.0.0.1\",\"80\",\"" +
+            (up ? "CONNECTED" : "CLOSED") + "\"\r\n\r\nOK\r\n");
+    } else if (startsWith(cmd, "+CIPCLOSE=")) {
+      long mux = num(split(cmd.substr(10)), 0);
+      closeSocket(mux);
+      reply("\r\n" + itos(mux) + ", CLOSE OK\r\n");
+    } else if (cmd == "+CIPSHUT") {
+      reply("\r\nSHUT OK\r\n");
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  // Quick send mode: a payload the socket has no room for is dropped after
+  // it came, with SEND FAIL in place of DATA ACCEPT, and so is every one
+  // after it on the connection
+  void handlePayload(uint8_t mux, const std::string& payload) override {
+    if (failed[mux] || unacked(mux) + payload.size() > tx_window) {
+      failed[mux] = true;
+      reply("\r\n" + itos(mux) + ", SEND FAIL\r\n");
+      return;
+    }
+    inflight[mux].push_back(
+        Sent(hostClockNs() + EMU_ACK_DELAY_NS, sockets[mux].sink.size()));
+    sockets[mux].sink += payload;
+    reply("\r\nDATA ACCEPT:" + itos(mux) + "," + itos(payload.size()) +
+          "\r\n");
+  }
+
+ private:
+  // When the remote end acknowledges a payload, and where it starts
+  typedef std::pair<uint64_t, size_t> Sent;
+
+  // Sent bytes the remote end has not acknowledged by now
+  size_t unacked(long mux) {
+    std::deque<Sent>& q = inflight[mux];
+    while (!q.empty() && q.front().first <= hostClockNs()) q.pop_front();
+    return q.empty() ? 0 : sockets[mux].sink.size() - q.front().second;
+  }
+
+  bool cipmux;   // several connections
+  bool cipmode;  // transparent mode
+  std::deque<Sent> inflight[EMU_MUX_COUNT];
+  bool             failed[EMU_MUX_COUNT];  // a send failed since CIPSTART
+};
+
+/*
+ * Quectel BG96: +QIOPEN / +QISEND / +QIRD
+ */
+
+class EmuBG96 : public ModemEmulator {
+ public:
+  explicit EmuBG96(uint32_t baud) : ModemEmulator(baud) {
+    for (int i = 0; i < EMU_MUX_COUNT; i++) push[i] = false;
+  }
+  const char* name() const override {
+    return "BG96";
+  }
+
+ protected:
+  bool handleCommand(const std::string& cmd) override {
+    if (cmd == "+GMM") {
+      reply("\r\nBG96\r\n\r\nOK\r\n");
+    } else if (startsWith(cmd, "+QIOPEN=")) {
+      std::vector<std::string> a   = split(cmd.substr(8));
+      long                     mux = num(a, 1);
+      if (!openSocket(mux)) {
+        error();
+        return true;
+      }
+      push[mux] = num(a, 6) == 1;
+      ok();
+      reply("\r\n+QIOPEN: " + itos(mux) + ",0\r\n");
+      if (unread(mux) && !push[mux]) {
+        reply("\r\n+QIURC: \"recv\"," + itos(mux) + "\r\n");
+      }
+    } else if (startsWith(cmd, "+QISWTMD=")) {
+      std::vector<std::string> a   = split(cmd.substr(9));
+      long                     mux = num(a, 0);
+      if (mux < 0 || mux >= EMU_MUX_COUNT || !sockets[mux].open) {
+        error();
+        return true;
+      }
+      push[mux] = num(a, 1) == 1;
+      ok();
+    } else if (startsWith(cmd, "+QISEND=")) {
+      std::vector<std::string> a   = split(cmd.substr(8));
+      long                     mux = num(a, 0);
+      long                     len = num(a, 1);
+      if (mux < 0 || mux >= EMU_MUX_COUNT || !sockets[mux].open || len <= 0 ||
+          len > 1460) {
+        error();
+        return true;
+      }
+      reply("\r\n> ");
+      expectPayload(mux, len);
+    } else if (startsWith(cmd, "+QIRD=")) {
+      std::vector<std::string> a    = split(cmd.substr(6));
+      long                     mux  = num(a, 0);
+      long                     size = num(a, 1);
+      if (mux < 0 || mux >= EMU_MUX_COUNT) {
+        error();
+      } else if (size == 0) {
+        const Socket& s = sockets[mux];
+        reply("\r\n+QIRD: " + itos(s.read + unread(mux)) + "," + itos(s.read) +
+              "," + itos(unread(mux)) + "\r\n\r\nOK\r\n");
+      } else {
+        std::string data = take(mux, std::min<long>(size, 1500));
+        if (data.empty()) {
+          reply("\r\n+QIRD: 0\r\n\r\nOK\r\n");
+        } else {
+          reply("\r\n+QIRD: " + itos(data.size()) + "\r\n" + data +
+                "\r\n\r\nOK\r\n");
+        }
+      }
+    } else if (cmd == "+QISTATE=0,1") {
+      std::string r = "\r\n";
+      for (int mux = 0; mux < EMU_MUX_COUNT; mux++) {
+        if (!sockets[mux].open) continue;
+        r += "+QISTATE: " + itos(mux) +
+             ",\"TCP\",\"10.0.0.1\",80,5087,2,1,0,0,\"uart1\"\r\n";
+      }
+      reply(r + "\r\nOK\r\n");
+    } else if (startsWith(cmd, "+QISTATE=1,")) {
+      long mux = num(split(cmd.substr(11)), 0);
+      bool up  = mux >= 0 && mux < EMU_MUX_COUNT && sockets[mux].open;
+      reply("\r\n+QISTATE: " + itos(mux) +
+            ",\"TCP\",\"10.0.0.1\",80,5087," + (up ? "2" : "4") +
+            ",1,0,0,\"uart1\"\r\n\r\nOK\r\n");
+    } else if (startsWith(cmd, "+QICLOSE=")) {
+      closeSocket(num(split(cmd.substr(9)), 0));
+      ok();
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  void handlePayload(uint8_t mux, const std::string& payload) override {
+    sockets[mux].sink += payload;
+    reply("\r\nSEND OK\r\n");
+  }
+
+  // Direct push: what the remote end sends goes out as it comes, up to 1500
+  // bytes a URC
+  void lineIdle() override {
+    for (int mux = 0; mux < EMU_MUX_COUNT; mux++) {
+      if (!push[mux] || !sockets[mux].open || !unread(mux)) continue;
+      std::string data = take(mux, 1500);
+      send("\r\n+QIURC: \"recv\"," + itos(mux) + "," + itos(data.size()) +
+           "\r\n" + data);
+      return;
+    }
+  }
+
+ private:
+  bool push[EMU_MUX_COUNT];  // access mode 1, direct push
+};
+
+ModemEmulator* ModemEmulator::create(const char* dialect, uint32_t baud) {
+  if (strcasecmp(dialect, "SIM7000") == 0) return new EmuSim7000(baud);
+  if (strcasecmp(dialect, "SIM800") == 0) return new EmuSim800(baud);
+  if (strcasecmp(dialect, "BG96") == 0) return new EmuBG96(baud);
+  return NULL;
+}
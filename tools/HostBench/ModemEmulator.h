@@ -0,0 +1,205 @@
+/**
+ * @file       ModemEmulator.h
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Oct 2026
+ *
+ * A scriptable AT modem that lives on the far side of a simulated UART.
+ *
+ * The host side (TinyGSM) talks to it through the ordinary Stream interface.
+ * Every byte costs one character time at the configured baud rate on the
+ * virtual clock, and every command line is answered after a configurable
+ * processing latency, so the link time it reports is what a real module at
+ * that speed would take for the same dialogue.
+ *
+ * The socket dialogues of three families are built in:
+ *   - SIM7000  +CAOPEN / +CASEND / +CARECV
+ *   - SIM800   +CIPSTART / +CIPSEND / +CIPRXGET / +CIPACK
+ *   - BG96     +QIOPEN / +QISEND / +QIRD, or data pushed with +QIURC
+ * as are sending an SMS with +CMGS, the +CREG/+CGREG/+CEREG reports and
+ * the +CGEV bearer events.
+ * Anything else is answered from the script (see on() / loadScript()) or with
+ * a plain OK.
+ */
+
+#ifndef HOSTBENCH_MODEMEMULATOR_H_
+#define HOSTBENCH_MODEMEMULATOR_H_
+
+#include <Arduino.h>
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#define EMU_MUX_COUNT 16
+#define EMU_RX_WINDOW 8192
+// Bytes a socket holds that the remote end has not acknowledged by default,
+// and the time the acknowledgement takes
+#define EMU_TX_WINDOW 8192
+#define EMU_ACK_DELAY_NS 200000000ULL
+// Silence around the "+++" that leaves transparent mode
+#define EMU_ESCAPE_GUARD_NS 1000000000ULL
+
+class ModemEmulator : public Stream {
+ public:
+  static ModemEmulator* create(const char* dialect, uint32_t baud = 115200);
+
+  explicit ModemEmulator(uint32_t baud);
+  virtual ~ModemEmulator() {}
+
+  virtual const char* name() const = 0;
+
+  /*
+   * Stream, as seen from TinyGSM
+   */
+  int    available() override;
+  int    read() override;
+  int    peek() override;
+  size_t readBytes(char* buffer, size_t length) override;
+  using Stream::readBytes;
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* buf, size_t size) override;
+  using Print::write;
+
+  /*
+   * Configuration
+   */
+  // Time between the end of a command line and the first byte of its answer
+  void setLatency(uint32_t latency_us) {
+    latency_ns = latency_us * 1000ULL;
+  }
+  // Answer every command starting with `command` (after "AT") with `reply`
+  void on(const char* command, const char* reply);
+  // One rule per line: <command><TAB><reply>, with \r \n \" escapes in reply
+  bool loadScript(const char* path);
+  // Data the remote end sends on every socket opened after this call
+  void serve(const uint8_t* data, size_t len) {
+    download.assign(reinterpret_cast<const char*>(data), len);
+  }
+  // Registration status (<stat>, 1 when registered), reported with a URC
+  // wherever the host turned the reports on
+  void setRegistration(int stat);
+  // Brings the bearer up or down, with a +CGEV event if the host asked for them
+  void setBearer(bool up);
+  // Bytes a socket may hold that the remote end has not acknowledged; a send
+  // past them fails (SIM800)
+  void setTxWindow(size_t bytes) {
+    tx_window = bytes;
+  }
+  // Sends s to the host unasked, as the modem does a URC
+  void urc(const std::string& s) {
+    reply(s);
+  }
+  // Everything the host managed to send on a socket
+  const std::string& uploaded(uint8_t mux) const {
+    return sockets[mux % EMU_MUX_COUNT].sink;
+  }
+
+  /*
+   * Statistics
+   */
+  void resetStats() {
+    commands  = 0;
+    bytes_in  = 0;
+    bytes_out = 0;
+  }
+  uint32_t commands;   // AT command lines received
+  uint64_t bytes_in;   // bytes host -> modem
+  uint64_t bytes_out;  // bytes modem -> host
+
+ protected:
+  struct Socket {
+    bool        open;
+    std::string sink;    // uploaded by the host
+    std::string source;  // sent by the remote end
+    size_t      read;    // bytes of the source already handed to the host
+  };
+
+  struct Chunk {
+    uint64_t    start_ns;  // time the first byte starts on the wire
+    std::string data;
+    size_t      pos;
+  };
+
+  // Dialect hooks; return false to fall through to the common handlers
+  virtual bool handleCommand(const std::string& cmd) = 0;
+  virtual void handlePayload(uint8_t mux, const std::string& payload) = 0;
+
+  void reply(const std::string& s);
+  // Sends s unasked as soon as the line is free, with no processing latency,
+  // ahead of answers still being worked on
+  void send(const std::string& s);
+  // Called when the host polls with nothing on the line, to send more; also
+  // while the modem works on an answer
+  virtual void lineIdle() {}
+  void ok() {
+    reply("\r\nOK\r\n");
+  }
+  void error() {
+    reply("\r\nERROR\r\n");
+  }
+  // Switch to data mode for the next `len` bytes
+  void expectPayload(uint8_t mux, size_t len);
+  // Pass everything to the socket until "+++", which is answered with OK
+  void enterTransparent(uint8_t mux);
+
+  bool openSocket(uint8_t mux);
+  void closeSocket(uint8_t mux);
+  // What the modem holds for the host: the remote end keeps the socket
+  // buffer topped up to EMU_RX_WINDOW bytes until its data runs out
+  size_t unread(uint8_t mux) const {
+    const Socket& s    = sockets[mux % EMU_MUX_COUNT];
+    size_t        left = s.source.size() - s.read;
+    return left < EMU_RX_WINDOW ? left : EMU_RX_WINDOW;
+  }
+  std::string take(uint8_t mux, size_t len);
+
+  // Splits "a,\"b,c\",d" into {"a", "b,c", "d"}
+  static std::vector<std::string> split(const std::string& args);
+  static long                     num(const std::vector<std::string>& args,
+                                      size_t index);
+  static std::string              hex(const std::string& data);
+
+  Socket sockets[EMU_MUX_COUNT];
+  size_t tx_window;
+
+ private:
+  void lineReceived(const std::string& line);
+  bool handleCommon(const std::string& cmd);
+  bool handleScript(const std::string& cmd);
+  // 0..2 for +CREG, +CGREG and +CEREG commands, else -1
+  static int  regDomain(const std::string& cmd);
+  std::string regReport(int n) const;
+  void settle();
+  void queue(const std::string& s, uint64_t start_ns);
+  size_t ready();
+  void passThrough(uint8_t c);
+
+  uint64_t byte_ns;
+  uint64_t latency_ns;
+  uint64_t wire_free_ns;  // modem -> host line is busy until then
+
+  std::deque<Chunk> tx;
+  std::string       line;
+  size_t            payload_left;
+  uint8_t           payload_mux;
+  std::string       payload;
+  bool              skip_lf;
+  bool              sms_text;  // taking an SMS body, up to Ctrl-Z
+  bool              transparent;
+  uint8_t           transparent_mux;
+  std::string       escape;        // the "+" of a "+++" so far
+  uint64_t          last_data_ns;  // when the last byte for the socket came
+  bool              trace;  // log command lines to stderr (EMU_TRACE=1)
+  int               reg_stat;
+  int               reg_n[3];  // +CREG, +CGREG and +CEREG report modes
+  bool              bearer;
+  bool              cgerep;  // +CGEV events on
+
+  std::map<std::string, std::string> script;
+  std::string                        download;
+};
+
+#endif  // HOSTBENCH_MODEMEMULATOR_H_
@@ -0,0 +1,370 @@
+/**
+ * @file       SocketBench.cpp
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Oct 2026
+ *
+ * Pushes a file through GsmClient::read() and GsmClient::write() against the
+ * modem emulator.  Reports the link time init(), gprsConnect() and connect()
+ * take together, then for each direction:
+ *   - payload throughput over the simulated link (bytes per virtual second)
+ *   - AT command round trips per KiB of payload
+ *   - host CPU time spent per payload byte
+ * On the SIM7000 the file is then uploaded once more through a bulk send
+ * session (transparent mode), the SIM800 uploads it once more to a socket
+ * that runs out of room (sfail, OK when write() reports the failed send) and
+ * goes through it both ways with the transparent client, and the BG96 reads
+ * it once more with the modem pushing the data (direct push mode).
+ *
+ * Build one binary per modem family, e.g. -DTINY_GSM_MODEM_SIM7000.
+ */
+
+#include <TinyGsmClient.h>
+
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "ModemEmulator.h"
+
+#if defined(TINY_GSM_MODEM_SIM7000)
+#define BENCH_DIALECT "SIM7000"
+#elif defined(TINY_GSM_MODEM_SIM800)
+#define BENCH_DIALECT "SIM800"
+#elif defined(TINY_GSM_MODEM_BG96)
+#define BENCH_DIALECT "BG96"
+#else
+#error "SocketBench supports TINY_GSM_MODEM_SIM7000, _SIM800 and _BG96"
+#endif
+
+// A read that makes no progress for this long (virtual time) ends the run
+#define BENCH_STALL_MS 60000UL
+
+// Receive buffer of the BG96 client in direct push mode
+#define BENCH_PUSH_BUFFER 8192
+// Time (virtual) the BG96 spends on other commands before the push run reads
+#define BENCH_PUSH_BUSY_MS 2000UL
+
+// Room of the SIM800 socket in the send failure run
+#define BENCH_FAIL_WINDOW 2048
+
+static uint64_t cpuNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+struct Result {
+  size_t   bytes;
+  uint64_t link_ns;
+  uint64_t cpu_ns;
+  uint32_t commands;
+  bool     ok;
+};
+
+static void report(const char* what, const Result& r) {
+  double secs = r.link_ns / 1e9;
+  printf("%-8s %-6s %9zu B  %8.2f s  %10.0f B/s  %7.2f AT/KiB  %8.1f ns/B"
+         "  %s\n",
+         BENCH_DIALECT, what, r.bytes, secs, secs > 0 ? r.bytes / secs : 0.0,
+         r.bytes ? r.commands * 1024.0 / r.bytes : 0.0,
+         r.bytes ? static_cast<double>(r.cpu_ns) / r.bytes : 0.0,
+         r.ok ? "OK" : "MISMATCH");
+}
+
+static bool loadFile(const char* path, std::string& out) {
+  FILE* f = fopen(path, "rb");
+  if (!f) return false;
+  char   buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.append(buf, n);
+  fclose(f);
+  return true;
+}
+
+int main(int argc, char** argv) {
+  const char* file       = "../../extras/test_1m.bin";
+  const char* script     = NULL;
+  uint32_t    baud       = 115200;
+  uint32_t    latency_us = 5000;
+  size_t      read_chunk = 512;
+  size_t      write_chunk = 1024;
+  size_t      rx_buffer   = 0;
+  size_t      tx_buffer   = 0;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "f:b:l:r:w:s:x:t:")) != -1) {
+    switch (opt) {
+      case 'f': file = optarg; break;
+      case 'b': baud = atol(optarg); break;
+      case 'l': latency_us = atol(optarg); break;
+      case 'r': read_chunk = atol(optarg); break;
+      case 'w': write_chunk = atol(optarg); break;
+      case 's': script = optarg; break;
+      case 'x': rx_buffer = atol(optarg); break;
+      case 't': tx_buffer = atol(optarg); break;
+      default:
+        fprintf(stderr,
+                "usage: %s [-f file] [-b baud] [-l latency_us] "
+                "[-r read_chunk] [-w write_chunk] [-s script] "
+                "[-x rx_buffer] [-t tx_buffer]\n",
+                argv[0]);
+        return 2;
+    }
+  }
+
+  std::string data;
+  if (!loadFile(file, data) || data.empty()) {
+    fprintf(stderr, "cannot read %s\n", file);
+    return 1;
+  }
+  if (!read_chunk || !write_chunk) {
+    fprintf(stderr, "chunk sizes must be non-zero\n");
+    return 2;
+  }
+
+  ModemEmulator* emu = ModemEmulator::create(BENCH_DIALECT, baud);
+  emu->setLatency(latency_us);
+  if (script && !emu->loadScript(script)) {
+    fprintf(stderr, "cannot read %s\n", script);
+    return 1;
+  }
+  emu->serve(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+
+  TinyGsm       modem(*emu);
+  TinyGsmClient client(modem, 0);
+  uint8_t*      rx = rx_buffer ? new uint8_t[rx_buffer] : NULL;
+  client.setRxBuffer(rx, rx_buffer);
+  uint8_t*      tx = tx_buffer ? new uint8_t[tx_buffer] : NULL;
+  client.setTxBuffer(tx, tx_buffer);
+  uint64_t setup0 = hostClockNs();
+  if (!modem.init()) {
+    fprintf(stderr, "modem init failed\n");
+    return 1;
+  }
+  if (!modem.gprsConnect("internet")) {
+    fprintf(stderr, "gprs connect failed\n");
+    return 1;
+  }
+  if (!client.connect("10.0.0.1", 80)) {
+    fprintf(stderr, "connect failed\n");
+    return 1;
+  }
+  printf("%-8s %-6s %9.3f s  %3u AT\n", BENCH_DIALECT, "setup",
+         (hostClockNs() - setup0) / 1e9, emu->commands);
+
+  // Download
+  std::string got;
+  got.reserve(data.size());
+  uint8_t* buf = new uint8_t[read_chunk > write_chunk ? read_chunk
+                                                      : write_chunk];
+  emu->resetStats();
+  uint64_t link0 = hostClockNs();
+  uint64_t cpu0  = cpuNs();
+  uint32_t last  = millis();
+  while (got.size() < data.size() && millis() - last < BENCH_STALL_MS) {
+    int n = client.read(buf, read_chunk);
+    if (n > 0) {
+      got.append(reinterpret_cast<char*>(buf), n);
+      last = millis();
+    } else {
+      delay(1);
+    }
+  }
+  Result down;
+  down.bytes    = got.size();
+  down.link_ns  = hostClockNs() - link0;
+  down.cpu_ns   = cpuNs() - cpu0;
+  down.commands = emu->commands;
+  down.ok       = got == data;
+  report("read", down);
+
+  // Upload
+  emu->resetStats();
+  link0         = hostClockNs();
+  cpu0          = cpuNs();
+  size_t sent   = 0;
+  while (sent < data.size()) {
+    size_t len = data.size() - sent;
+    if (len > write_chunk) len = write_chunk;
+    size_t n = client.write(
+        reinterpret_cast<const uint8_t*>(data.data()) + sent, len);
+    if (!n) break;
+    sent += n;
+  }
+  client.flush();
+  Result up;
+  up.bytes    = sent;
+  up.link_ns  = hostClockNs() - link0;
+  up.cpu_ns   = cpuNs() - cpu0;
+  up.commands = emu->commands;
+  up.ok       = emu->uploaded(0) == data;
+  report("write", up);
+
+#if defined(TINY_GSM_MODEM_SIM7000)
+  // Upload through a bulk send session
+  size_t before = emu->uploaded(0).size();
+  emu->resetStats();
+  link0 = hostClockNs();
+  cpu0  = cpuNs();
+  sent  = 0;
+  {
+    TinyGsmClient::BulkSend session(client);
+    while (session && sent < data.size()) {
+      size_t len = data.size() - sent;
+      if (len > write_chunk) len = write_chunk;
+      size_t n = session.write(
+          reinterpret_cast<const uint8_t*>(data.data()) + sent, len);
+      if (!n) break;
+      sent += n;
+    }
+    if (!session.end()) sent = 0;
+  }
+  Result bulk;
+  bulk.bytes    = sent;
+  bulk.link_ns  = hostClockNs() - link0;
+  bulk.cpu_ns   = cpuNs() - cpu0;
+  bulk.commands = emu->commands;
+  bulk.ok       = emu->uploaded(0).substr(before) == data;
+  report("bulk", bulk);
+  up.ok = up.ok && bulk.ok;
+#endif
+
+#if defined(TINY_GSM_MODEM_BG96)
+  // Down again with the modem pushing the data
+  client.stop();
+  uint8_t* pushed = new uint8_t[BENCH_PUSH_BUFFER];
+  client.setRxBuffer(pushed, BENCH_PUSH_BUFFER);
+  client.setDirectPush(true);
+  bool push_up = client.connect("10.0.0.1", 80);
+  // Busy with other commands first: the client, out of room, goes back to
+  // buffer mode before one of them rather than lose what the modem pushes
+  for (uint32_t t0 = millis(); millis() - t0 < BENCH_PUSH_BUSY_MS;) {
+    modem.getSignalQuality();
+  }
+  got.clear();
+  emu->resetStats();
+  link0 = hostClockNs();
+  cpu0  = cpuNs();
+  last  = millis();
+  while (push_up && got.size() < data.size() &&
+         millis() - last < BENCH_STALL_MS) {
+    int n = client.read(buf, read_chunk);
+    if (n > 0) {
+      got.append(reinterpret_cast<char*>(buf), n);
+      last = millis();
+    } else {
+      delay(1);
+    }
+  }
+  Result pdown;
+  pdown.bytes    = got.size();
+  pdown.link_ns  = hostClockNs() - link0;
+  pdown.cpu_ns   = cpuNs() - cpu0;
+  pdown.commands = emu->commands;
+  pdown.ok       = got == data;
+  report("push", pdown);
+  client.stop();
+  client.setRxBuffer(rx, rx_buffer);
+  delete[] pushed;
+  down.ok = down.ok && pdown.ok;
+#endif
+
+#if defined(TINY_GSM_MODEM_SIM800)
+  // Up again on a socket with less room than the send window: once the modem
+  // answers a send with SEND FAIL, write() returns 0 and the data it took is
+  // all the remote end got
+  client.connect("10.0.0.1", 80);
+  emu->setTxWindow(BENCH_FAIL_WINDOW);
+  emu->resetStats();
+  link0 = hostClockNs();
+  cpu0  = cpuNs();
+  sent  = 0;
+  while (client.connected() && sent < data.size()) {
+    size_t len = data.size() - sent;
+    if (len > write_chunk) len = write_chunk;
+    size_t n = client.write(
+        reinterpret_cast<const uint8_t*>(data.data()) + sent, len);
+    if (!n) break;
+    sent += n;
+  }
+  client.flush();
+  Result fup;
+  fup.bytes    = sent;
+  fup.link_ns  = hostClockNs() - link0;
+  fup.cpu_ns   = cpuNs() - cpu0;
+  fup.commands = emu->commands;
+  fup.ok       = sent < data.size() &&
+           client.write(reinterpret_cast<const uint8_t*>(data.data()), 1) ==
+               0 &&
+           emu->uploaded(0) == data.substr(0, emu->uploaded(0).size());
+  report("sfail", fup);
+  emu->setTxWindow(EMU_TX_WINDOW);
+  up.ok = up.ok && fup.ok;
+
+  // Both ways again in transparent mode, on a bearer set up for it
+  client.stop();
+  modem.setTransparentMode(true);
+  bool                     tp_up = modem.gprsConnect("internet");
+  TinyGsmClientTransparent tp(modem);
+  tp_up = tp_up && tp.connect("10.0.0.1", 80);
+  got.clear();
+  emu->resetStats();
+  link0 = hostClockNs();
+  cpu0  = cpuNs();
+  last  = millis();
+  while (tp_up && got.size() < data.size() &&
+         millis() - last < BENCH_STALL_MS) {
+    int n = tp.read(buf, read_chunk);
+    if (n > 0) {
+      got.append(reinterpret_cast<char*>(buf), n);
+      last = millis();
+    } else {
+      delay(1);
+    }
+  }
+  Result tdown;
+  tdown.bytes    = got.size();
+  tdown.link_ns  = hostClockNs() - link0;
+  tdown.cpu_ns   = cpuNs() - cpu0;
+  tdown.commands = emu->commands;
+  tdown.ok       = got == data;
+  report("tread", tdown);
+
+  emu->resetStats();
+  link0 = hostClockNs();
+  cpu0  = cpuNs();
+  sent  = 0;
+  while (tp_up && sent < data.size()) {
+    size_t len = data.size() - sent;
+    if (len > write_chunk) len = write_chunk;
+    size_t n =
+        tp.write(reinterpret_cast<const uint8_t*>(data.data()) + sent, len);
+    if (!n) break;
+    sent += n;
+  }
+  tp.flush();
+  Result tup;
+  tup.bytes    = sent;
+  tup.link_ns  = hostClockNs() - link0;
+  tup.cpu_ns   = cpuNs() - cpu0;
+  tup.commands = emu->commands;
+  tup.ok       = emu->uploaded(0) == data;
+  report("twrite", tup);
+  // A command in between leaves data mode and the client goes back in
+  modem.getSignalQuality();
+  tup.ok = tup.ok && tp.connected() && tp.available() == 0;
+  tp.stop();
+  down.ok = down.ok && tdown.ok;
+  up.ok   = up.ok && tup.ok;
+#endif
+
+  delete[] buf;
+  delete[] rx;
+  delete[] tx;
+  delete emu;
+  return down.ok && up.ok ? 0 : 1;
+}
@@ -0,0 +1,499 @@
+/**
+ * @file       Arduino.cpp
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Oct 2026
+ */
+
+#include "Arduino.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+
+/*
+ * Virtual clock
+ */
+
+// Every clock read costs this much virtual time, so loops that only poll
+// millis() still run out eventually
+#define HOST_CLOCK_READ_NS 1000ULL
+
+static uint64_t host_clock_ns = 0;
+
+uint64_t hostClockNs() {
+  return host_clock_ns;
+}
+
+void hostClockAdvance(uint64_t ns) {
+  host_clock_ns += ns;
+}
+
+void hostClockAdvanceTo(uint64_t ns) {
+  if (ns > host_clock_ns) host_clock_ns = ns;
+}
+
+unsigned long millis() {
+  host_clock_ns += HOST_CLOCK_READ_NS;
+  return static_cast<unsigned long>(host_clock_ns / 1000000ULL);
+}
+
+unsigned long micros() {
+  host_clock_ns += HOST_CLOCK_READ_NS;
+  return static_cast<unsigned long>(host_clock_ns / 1000ULL);
+}
+
+void delay(unsigned long ms) {
+  host_clock_ns += ms * 1000000ULL;
+}
+
+void delayMicroseconds(unsigned int us) {
+  host_clock_ns += us * 1000ULL;
+}
+
+void yield() {}
+
+/*
+ * Serial
+ */
+
+HostSerial Serial;
+
+int HostSerial::available() {
+  // Nothing ever arrives; let time pass like an idle line would
+  delay(1);
+  return 0;
+}
+
+size_t HostSerial::write(uint8_t c) {
+  return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+/*
+ * Print
+ */
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+  size_t n = 0;
+  while (size--) {
+    if (write(*buffer++)) {
+      n++;
+    } else {
+      break;
+    }
+  }
+  return n;
+}
+
+size_t Print::print(const __FlashStringHelper* ifsh) {
+  return write(reinterpret_cast<const char*>(ifsh));
+}
+
+size_t Print::print(const String& s) {
+  return write(s.c_str(), s.length());
+}
+
+size_t Print::print(const char str[]) {
+  return write(str);
+}
+
+size_t Print::print(char c) {
+  return write(static_cast<uint8_t>(c));
+}
+
+size_t Print::print(unsigned char b, int base) {
+  return print(static_cast<unsigned long>(b), base);
+}
+
+size_t Print::print(int n, int base) {
+  return print(static_cast<long>(n), base);
+}
+
+size_t Print::print(unsigned int n, int base) {
+  return print(static_cast<unsigned long>(n), base);
+}
+
+size_t Print::print(long n, int base) {
+  return print(static_cast<long long>(n), base);
+}
+
+size_t Print::print(unsigned long n, int base) {
+  return print(static_cast<unsigned long long>(n), base);
+}
+
+size_t Print::print(long long n, int base) {
+  if (base == 0) return write(static_cast<uint8_t>(n));
+  if (base == 10 && n < 0) {
+    size_t t = print('-');
+    return printNumber(0ULL - static_cast<unsigned long long>(n), 10) + t;
+  }
+  return printNumber(static_cast<unsigned long long>(n), base);
+}
+
+size_t Print::print(unsigned long long n, int base) {
+  if (base == 0) return write(static_cast<uint8_t>(n));
+  return printNumber(n, base);
+}
+
+size_t Print::print(double n, int digits) {
+  return printFloat(n, digits);
+}
+
+size_t Print::print(const Printable& x) {
+  return x.printTo(*this);
+}
+
+size_t Print::println(void) {
+  return write("\r\n");
+}
+
+#define HOSTBENCH_PRINTLN(type, call) \
+  size_t Print::println(type x) {     \
+    size_t n = call;                  \
+    return n + println();             \
+  }
+HOSTBENCH_PRINTLN(const __FlashStringHelper*, print(x))
+HOSTBENCH_PRINTLN(const String&, print(x))
+HOSTBENCH_PRINTLN(const char*, print(x))
+HOSTBENCH_PRINTLN(char, print(x))
+HOSTBENCH_PRINTLN(const Printable&, print(x))
+#undef HOSTBENCH_PRINTLN
+
+#define HOSTBENCH_PRINTLN_BASE(type)  \
+  size_t Print::println(type x, int b) { \
+    size_t n = print(x, b);           \
+    return n + println();             \
+  }
+HOSTBENCH_PRINTLN_BASE(unsigned char)
+HOSTBENCH_PRINTLN_BASE(int)
+HOSTBENCH_PRINTLN_BASE(unsigned int)
+HOSTBENCH_PRINTLN_BASE(long)
+HOSTBENCH_PRINTLN_BASE(unsigned long)
+HOSTBENCH_PRINTLN_BASE(long long)
+HOSTBENCH_PRINTLN_BASE(unsigned long long)
+HOSTBENCH_PRINTLN_BASE(double)
+#undef HOSTBENCH_PRINTLN_BASE
+
+size_t Print::printNumber(unsigned long long n, uint8_t base) {
+  char  buf[8 * sizeof(n) + 1];
+  char* str = &buf[sizeof(buf) - 1];
+  *str      = '\0';
+  if (base < 2) base = 10;
+  do {
+    char c = n % base;
+    n /= base;
+    *--str = c < 10 ? c + '0' : c + 'A' - 10;
+  } while (n);
+  return write(str);
+}
+
+size_t Print::printFloat(double number, uint8_t digits) {
+  if (isnan(number)) return print("nan");
+  if (isinf(number)) return print("inf");
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", digits, number);
+  return write(buf);
+}
+
+/*
+ * Stream
+ */
+
+int Stream::timedRead() {
+  int c;
+  _startMillis = millis();
+  do {
+    c = read();
+    if (c >= 0) return c;
+  } while (millis() - _startMillis < _timeout);
+  return -1;
+}
+
+int Stream::timedPeek() {
+  int c;
+  _startMillis = millis();
+  do {
+    c = peek();
+    if (c >= 0) return c;
+  } while (millis() - _startMillis < _timeout);
+  return -1;
+}
+
+int Stream::peekNextDigit(bool detectDecimal) {
+  int c;
+  while (1) {
+    c = timedPeek();
+    if (c < 0 || c == '-' || (c >= '0' && c <= '9') ||
+        (detectDecimal && c == '.'))
+      return c;
+    read();
+  }
+}
+
+bool Stream::find(const char* target) {
+  return find(target, strlen(target));
+}
+
+bool Stream::find(const char* target, size_t length) {
+  return findUntil(target, NULL) && length;
+}
+
+bool Stream::findUntil(const char* target, const char* terminator) {
+  size_t targetLen = strlen(target);
+  size_t termLen   = terminator ? strlen(terminator) : 0;
+  size_t index     = 0;
+  size_t termIndex = 0;
+  if (targetLen == 0) return true;
+  int c;
+  while ((c = timedRead()) > 0) {
+    if (c == target[index]) {
+      if (++index >= targetLen) return true;
+    } else {
+      index = (c == target[0]) ? 1 : 0;
+    }
+    if (termLen > 0 && c == terminator[termIndex]) {
+      if (++termIndex >= termLen) return false;
+    } else {
+      termIndex = 0;
+    }
+  }
+  return false;
+}
+
+long Stream::parseInt() {
+  bool isNegative = false;
+  long value      = 0;
+  int  c          = peekNextDigit(false);
+  if (c < 0) return 0;
+  do {
+    if (c == '-') {
+      isNegative = true;
+    } else if (c >= '0' && c <= '9') {
+      value = value * 10 + c - '0';
+    }
+    read();
+    c = timedPeek();
+  } while ((c >= '0' && c <= '9'));
+  return isNegative ? -value : value;
+}
+
+float Stream::parseFloat() {
+  bool  isNegative = false;
+  bool  isFraction = false;
+  long  value      = 0;
+  float fraction   = 1.0;
+  int   c          = peekNextDigit(true);
+  if (c < 0) return 0;
+  do {
+    if (c == '-') {
+      isNegative = true;
+    } else if (c == '.') {
+      isFraction = true;
+    } else if (c >= '0' && c <= '9') {
+      value = value * 10 + c - '0';
+      if (isFraction) fraction *= 0.1;
+    }
+    read();
+    c = timedPeek();
+  } while ((c >= '0' && c <= '9') || (c == '.' && !isFraction));
+  if (isNegative) value = -value;
+  return isFraction ? value * fraction : value;
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+  size_t count = 0;
+  while (count < length) {
+    int c = timedRead();
+    if (c < 0) break;
+    *buffer++ = static_cast<char>(c);
+    count++;
+  }
+  return count;
+}
+
+size_t Stream::readBytesUntil(char terminator, char* buffer, size_t length) {
+  size_t index = 0;
+  while (index < length) {
+    int c = timedRead();
+    if (c < 0 || c == terminator) break;
+    *buffer++ = static_cast<char>(c);
+    index++;
+  }
+  return index;
+}
+
+String Stream::readString() {
+  String ret;
+  int    c = timedRead();
+  while (c >= 0) {
+    ret += static_cast<char>(c);
+    c = timedRead();
+  }
+  return ret;
+}
+
+String Stream::readStringUntil(char terminator) {
+  String ret;
+  int    c = timedRead();
+  while (c >= 0 && c != terminator) {
+    ret += static_cast<char>(c);
+    c = timedRead();
+  }
+  return ret;
+}
+
+/*
+ * String
+ */
+
+static std::string hostUtoa(unsigned long long value, unsigned char base) {
+  char  buf[8 * sizeof(value) + 1];
+  char* str = &buf[sizeof(buf) - 1];
+  *str      = '\0';
+  if (base < 2) base = 10;
+  do {
+    char c = value % base;
+    value /= base;
+    *--str = c < 10 ? c + '0' : c + 'a' - 10;
+  } while (value);
+  return std::string(str);
+}
+
+static std::string hostLtoa(long long value, unsigned char base) {
+  if (base == 10 && value < 0) {
+    return "-" + hostUtoa(0ULL - static_cast<unsigned long long>(value), 10);
+  }
+  return hostUtoa(static_cast<unsigned long long>(value), base);
+}
+
+static std::string hostDtostr(double value, unsigned char decimalPlaces) {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value);
+  return std::string(buf);
+}
+
+String::String(unsigned char value, unsigned char base)
+    : s_(hostUtoa(value, base)) {}
+String::String(int value, unsigned char base) : s_(hostLtoa(value, base)) {}
+String::String(unsigned int value, unsigned char base)
+    : s_(hostUtoa(value, base)) {}
+String::String(long value, unsigned char base) : s_(hostLtoa(value, base)) {}
+String::String(unsigned long value, unsigned char base)
+    : s_(hostUtoa(value, base)) {}
+String::String(float value, unsigned char decimalPlaces)
+    : s_(hostDtostr(value, decimalPlaces)) {}
+String::String(double value, unsigned char decimalPlaces)
+    : s_(hostDtostr(value, decimalPlaces)) {}
+
+unsigned char String::equalsIgnoreCase(const String& s) const {
+  if (s_.length() != s.s_.length()) return 0;
+  for (size_t i = 0; i < s_.length(); i++) {
+    if (tolower(s_[i]) != tolower(s.s_[i])) return 0;
+  }
+  return 1;
+}
+
+void String::getBytes(unsigned char* buf, unsigned int bufsize,
+                      unsigned int index) const {
+  if (!bufsize || !buf) return;
+  if (index >= s_.length()) {
+    buf[0] = 0;
+    return;
+  }
+  size_t n = std::min<size_t>(bufsize - 1, s_.length() - index);
+  memcpy(buf, s_.data() + index, n);
+  buf[n] = 0;
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const {
+  size_t i = s_.find(ch, fromIndex);
+  return i == std::string::npos ? -1 : static_cast<int>(i);
+}
+
+int String::indexOf(const String& str, unsigned int fromIndex) const {
+  size_t i = s_.find(str.s_, fromIndex);
+  return i == std::string::npos ? -1 : static_cast<int>(i);
+}
+
+int String::lastIndexOf(char ch) const {
+  return lastIndexOf(ch, length() - 1);
+}
+
+int String::lastIndexOf(char ch, unsigned int fromIndex) const {
+  if (fromIndex >= s_.length()) return -1;
+  size_t i = s_.rfind(ch, fromIndex);
+  return i == std::string::npos ? -1 : static_cast<int>(i);
+}
+
+int String::lastIndexOf(const String& str) const {
+  return lastIndexOf(str, length() - str.length());
+}
+
+int String::lastIndexOf(const String& str, unsigned int fromIndex) const {
+  if (str.s_.length() == 0 || str.s_.length() > s_.length() ||
+      fromIndex >= s_.length())
+    return -1;
+  size_t i = s_.rfind(str.s_, fromIndex);
+  return i == std::string::npos ? -1 : static_cast<int>(i);
+}
+
+String String::substring(unsigned int left, unsigned int right) const {
+  if (left > right) std::swap(left, right);
+  String out;
+  if (left >= s_.length()) return out;
+  if (right > s_.length()) right = s_.length();
+  out.s_ = s_.substr(left, right - left);
+  return out;
+}
+
+void String::replace(char find, char replace) {
+  std::replace(s_.begin(), s_.end(), find, replace);
+}
+
+void String::replace(const String& find, const String& replace) {
+  if (find.s_.empty()) return;
+  size_t pos = 0;
+  while ((pos = s_.find(find.s_, pos)) != std::string::npos) {
+    s_.replace(pos, find.s_.length(), replace.s_);
+    pos += replace.s_.length();
+  }
+}
+
+void String::remove(unsigned int index) {
+  if (index < s_.length()) s_.erase(index);
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+  if (index < s_.length()) s_.erase(index, count);
+}
+
+void String::toLowerCase() {
+  for (size_t i = 0; i < s_.length(); i++) s_[i] = tolower(s_[i]);
+}
+
+void String::toUpperCase() {
+  for (size_t i = 0; i < s_.length(); i++) s_[i] = toupper(s_[i]);
+}
+
+void String::trim() {
+  size_t begin = 0;
+  size_t end   = s_.length();
+  while (begin < end && isspace(static_cast<unsigned char>(s_[begin])))
+    begin++;
+  while (end > begin && isspace(static_cast<unsigned char>(s_[end - 1])))
+    end--;
+  s_ = s_.substr(begin, end - begin);
+}
+
+long String::toInt() const {
+  return atol(s_.c_str());
+}
+
+float String::toFloat() const {
+  return static_cast<float>(atof(s_.c_str()));
+}
+
+double String::toDouble() const {
+  return atof(s_.c_str());
+}
@@ -0,0 +1,109 @@
+/**
+ * @file       Arduino.h
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Oct 2026
+ *
+ * Minimal Arduino core shim so that TinyGSM can be built and benchmarked on a
+ * Linux host.  Only what the library itself needs is provided.
+ *
+ * Time is virtual: millis()/micros() read a nanosecond clock that is advanced
+ * by delay(), by the modem emulator as bytes cross the simulated UART, and by
+ * a small fixed amount on every clock read so that spin loops always finish.
+ */
+
+#ifndef HOSTBENCH_ARDUINO_H_
+#define HOSTBENCH_ARDUINO_H_
+
+#include <ctype.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef bool     boolean;
+typedef uint8_t  byte;
+typedef uint16_t word;
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*reinterpret_cast<const uint8_t*>(addr))
+#define strlen_P strlen
+#define memcpy_P memcpy
+
+class __FlashStringHelper;
+#define F(string_literal) \
+  (reinterpret_cast<const __FlashStringHelper*>(PSTR(string_literal)))
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+
+#define LOW 0x0
+#define HIGH 0x1
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+// GPIO is not simulated; writes are dropped and reads return LOW
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int  digitalRead(uint8_t) {
+  return LOW;
+}
+
+unsigned long millis();
+unsigned long micros();
+void          delay(unsigned long ms);
+void          delayMicroseconds(unsigned int us);
+void          yield();
+
+template <typename T, typename L, typename H>
+inline T constrain(T x, L low, H high) {
+  return x < low ? low : (x > high ? high : x);
+}
+
+inline bool isDigit(int c) {
+  return isdigit(c) != 0;
+}
+inline bool isSpace(int c) {
+  return isspace(c) != 0;
+}
+inline bool isAlpha(int c) {
+  return isalpha(c) != 0;
+}
+inline bool isHexadecimalDigit(int c) {
+  return isxdigit(c) != 0;
+}
+
+// Host-only extensions to drive the virtual clock
+uint64_t hostClockNs();
+void     hostClockAdvance(uint64_t ns);
+void     hostClockAdvanceTo(uint64_t ns);
+
+// A do-nothing serial port; TX goes to stdout, RX is always empty
+class HostSerial : public Stream {
+ public:
+  void begin(unsigned long) {}
+  void end() {}
+
+  int available() override;
+  int read() override {
+    return -1;
+  }
+  int peek() override {
+    return -1;
+  }
+  size_t write(uint8_t c) override;
+  using Print::write;
+
+  operator bool() {
+    return true;
+  }
+};
+
+extern HostSerial Serial;
+
+#endif  // HOSTBENCH_ARDUINO_H_
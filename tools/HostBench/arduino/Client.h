@@ -0,0 +1,15 @@
+/**
+ * @file       Client.h
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Oct 2026
+ */
+
+#ifndef HOSTBENCH_CLIENT_H_
+#define HOSTBENCH_CLIENT_H_
+
+#include "Arduino.h"
+#include "ArduinoCompat/Client.h"
+
+#endif  // HOSTBENCH_CLIENT_H_
@@ -0,0 +1,86 @@
+/**
+ * @file       Print.h
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Oct 2026
+ */
+
+#ifndef HOSTBENCH_PRINT_H_
+#define HOSTBENCH_PRINT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Printable.h"
+#include "WString.h"
+
+class Print {
+ public:
+  Print() : write_error(0) {}
+  virtual ~Print() {}
+
+  int getWriteError() {
+    return write_error;
+  }
+  void clearWriteError() {
+    write_error = 0;
+  }
+
+  virtual size_t write(uint8_t) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size);
+  size_t         write(const char* str) {
+    if (str == NULL) return 0;
+    return write(reinterpret_cast<const uint8_t*>(str), strlen(str));
+  }
+  size_t write(const char* buffer, size_t size) {
+    return write(reinterpret_cast<const uint8_t*>(buffer), size);
+  }
+
+  virtual int availableForWrite() {
+    return 0;
+  }
+  virtual void flush() {}
+
+  size_t print(const __FlashStringHelper*);
+  size_t print(const String&);
+  size_t print(const char[]);
+  size_t print(char);
+  size_t print(unsigned char, int = DEC);
+  size_t print(int, int = DEC);
+  size_t print(unsigned int, int = DEC);
+  size_t print(long, int = DEC);
+  size_t print(unsigned long, int = DEC);
+  size_t print(long long, int = DEC);
+  size_t print(unsigned long long, int = DEC);
+  size_t print(double, int = 2);
+  size_t print(const Printable&);
+
+  size_t println(const __FlashStringHelper*);
+  size_t println(const String& s);
+  size_t println(const char[]);
+  size_t println(char);
+  size_t println(unsigned char, int = DEC);
+  size_t println(int, int = DEC);
+  size_t println(unsigned int, int = DEC);
+  size_t println(long, int = DEC);
+  size_t println(unsigned long, int = DEC);
+  size_t println(long long, int = DEC);
+  size_t println(unsigned long long, int = DEC);
+  size_t println(double, int = 2);
+  size_t println(const Printable&);
+  size_t println(void);
+
+ protected:
+  void setWriteError(int err = 1) {
+    write_error = err;
+  }
+
+ private:
+  int    write_error;
+  size_t printNumber(unsigned long long, uint8_t);
+  size_t printFloat(double, uint8_t);
+};
+
+#endif  // HOSTBENCH_PRINT_H_
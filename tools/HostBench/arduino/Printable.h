@@ -0,0 +1,22 @@
+/**
+ * @file       Printable.h
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Oct 2026
+ */
+
+#ifndef HOSTBENCH_PRINTABLE_H_
+#define HOSTBENCH_PRINTABLE_H_
+
+#include <stddef.h>
+
+class Print;
+
+class Printable {
+ public:
+  virtual ~Printable() {}
+  virtual size_t printTo(Print& p) const = 0;
+};
+
+#endif  // HOSTBENCH_PRINTABLE_H_
@@ -0,0 +1,59 @@
+/**
+ * @file       Stream.h
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Oct 2026
+ */
+
+#ifndef HOSTBENCH_STREAM_H_
+#define HOSTBENCH_STREAM_H_
+
+#include "Print.h"
+
+class Stream : public Print {
+ public:
+  Stream() : _timeout(1000), _startMillis(0) {}
+
+  virtual int available() = 0;
+  virtual int read()      = 0;
+  virtual int peek()      = 0;
+
+  void setTimeout(unsigned long timeout) {
+    _timeout = timeout;
+  }
+  unsigned long getTimeout() {
+    return _timeout;
+  }
+
+  bool find(const char* target);
+  bool find(const char* target, size_t length);
+  bool findUntil(const char* target, const char* terminator);
+
+  long  parseInt();
+  float parseFloat();
+
+  // Virtual as in the ESP8266/ESP32 cores, whose UARTs copy in bulk
+  virtual size_t readBytes(char* buffer, size_t length);
+  size_t         readBytes(uint8_t* buffer, size_t length) {
+    return readBytes(reinterpret_cast<char*>(buffer), length);
+  }
+  size_t readBytesUntil(char terminator, char* buffer, size_t length);
+  size_t readBytesUntil(char terminator, uint8_t* buffer, size_t length) {
+    return readBytesUntil(terminator, reinterpret_cast<char*>(buffer),
+                          length);
+  }
+
+  String readString();
+  String readStringUntil(char terminator);
+
+ protected:
+  int timedRead();
+  int timedPeek();
+  int peekNextDigit(bool detectDecimal);
+
+  unsigned long _timeout;
+  unsigned long _startMillis;
+};
+
+#endif  // HOSTBENCH_STREAM_H_
@@ -0,0 +1,215 @@
+/**
+ * @file       WString.h
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Oct 2026
+ *
+ * Arduino String on top of std::string.  The member set mirrors the AVR core
+ * so that code which builds here also builds there.
+ */
+
+#ifndef HOSTBENCH_WSTRING_H_
+#define HOSTBENCH_WSTRING_H_
+
+#include <stddef.h>
+#include <string>
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class __FlashStringHelper;
+
+class String {
+ public:
+  String(const char* cstr = "") : s_(cstr ? cstr : "") {}
+  String(const String& str) : s_(str.s_) {}
+  String(const __FlashStringHelper* str)  // NOLINT
+      : s_(reinterpret_cast<const char*>(str)) {}
+  explicit String(char c) : s_(1, c) {}
+  explicit String(unsigned char value, unsigned char base = 10);
+  explicit String(int value, unsigned char base = 10);
+  explicit String(unsigned int value, unsigned char base = 10);
+  explicit String(long value, unsigned char base = 10);
+  explicit String(unsigned long value, unsigned char base = 10);
+  explicit String(float value, unsigned char decimalPlaces = 2);
+  explicit String(double value, unsigned char decimalPlaces = 2);
+
+  String& operator=(const String& rhs) {
+    s_ = rhs.s_;
+    return *this;
+  }
+  String& operator=(const char* cstr) {
+    s_ = cstr ? cstr : "";
+    return *this;
+  }
+
+  unsigned char reserve(unsigned int size) {
+    s_.reserve(size);
+    return 1;
+  }
+  unsigned int length() const {
+    return static_cast<unsigned int>(s_.length());
+  }
+  const char* c_str() const {
+    return s_.c_str();
+  }
+
+  unsigned char concat(const String& str) {
+    s_ += str.s_;
+    return 1;
+  }
+  unsigned char concat(const char* cstr) {
+    if (cstr) s_ += cstr;
+    return 1;
+  }
+  unsigned char concat(const __FlashStringHelper* str) {
+    return concat(reinterpret_cast<const char*>(str));
+  }
+  unsigned char concat(char c) {
+    s_ += c;
+    return 1;
+  }
+  unsigned char concat(unsigned char num) {
+    return concat(String(num));
+  }
+  unsigned char concat(int num) {
+    return concat(String(num));
+  }
+  unsigned char concat(unsigned int num) {
+    return concat(String(num));
+  }
+  unsigned char concat(long num) {
+    return concat(String(num));
+  }
+  unsigned char concat(unsigned long num) {
+    return concat(String(num));
+  }
+  unsigned char concat(float num) {
+    return concat(String(num));
+  }
+  unsigned char concat(double num) {
+    return concat(String(num));
+  }
+
+  template <typename T>
+  String& operator+=(const T& rhs) {
+    concat(rhs);
+    return *this;
+  }
+  String& operator+=(const char* rhs) {
+    concat(rhs);
+    return *this;
+  }
+
+  int compareTo(const String& s) const {
+    return s_.compare(s.s_);
+  }
+  unsigned char equals(const String& s) const {
+    return s_ == s.s_;
+  }
+  unsigned char equals(const char* cstr) const {
+    return s_ == (cstr ? cstr : "");
+  }
+  unsigned char equalsIgnoreCase(const String& s) const;
+  unsigned char operator==(const String& rhs) const {
+    return equals(rhs);
+  }
+  unsigned char operator==(const char* cstr) const {
+    return equals(cstr);
+  }
+  unsigned char operator!=(const String& rhs) const {
+    return !equals(rhs);
+  }
+  unsigned char operator!=(const char* cstr) const {
+    return !equals(cstr);
+  }
+  unsigned char operator<(const String& rhs) const {
+    return compareTo(rhs) < 0;
+  }
+
+  unsigned char startsWith(const String& prefix) const {
+    return s_.compare(0, prefix.s_.length(), prefix.s_) == 0;
+  }
+  unsigned char startsWith(const String& prefix, unsigned int offset) const {
+    if (offset > s_.length()) return 0;
+    return s_.compare(offset, prefix.s_.length(), prefix.s_) == 0;
+  }
+  unsigned char endsWith(const String& suffix) const {
+    if (suffix.s_.length() > s_.length()) return 0;
+    return s_.compare(s_.length() - suffix.s_.length(), suffix.s_.length(),
+                      suffix.s_) == 0;
+  }
+
+  char charAt(unsigned int index) const {
+    return index < s_.length() ? s_[index] : 0;
+  }
+  void setCharAt(unsigned int index, char c) {
+    if (index < s_.length()) s_[index] = c;
+  }
+  char operator[](unsigned int index) const {
+    return charAt(index);
+  }
+  char& operator[](unsigned int index) {
+    return s_[index];
+  }
+  void getBytes(unsigned char* buf, unsigned int bufsize,
+                unsigned int index = 0) const;
+  void toCharArray(char* buf, unsigned int bufsize,
+                   unsigned int index = 0) const {
+    getBytes(reinterpret_cast<unsigned char*>(buf), bufsize, index);
+  }
+
+  int indexOf(char ch, unsigned int fromIndex = 0) const;
+  int indexOf(const String& str, unsigned int fromIndex = 0) const;
+  int lastIndexOf(char ch) const;
+  int lastIndexOf(char ch, unsigned int fromIndex) const;
+  int lastIndexOf(const String& str) const;
+  int lastIndexOf(const String& str, unsigned int fromIndex) const;
+
+  String substring(unsigned int beginIndex) const {
+    return substring(beginIndex, length());
+  }
+  String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+  void replace(char find, char replace);
+  void replace(const String& find, const String& replace);
+  void remove(unsigned int index);
+  void remove(unsigned int index, unsigned int count);
+  void toLowerCase();
+  void toUpperCase();
+  void trim();
+
+  long   toInt() const;
+  float  toFloat() const;
+  double toDouble() const;
+
+  friend String operator+(const String& lhs, const String& rhs) {
+    String s(lhs);
+    s.concat(rhs);
+    return s;
+  }
+  friend String operator+(const String& lhs, const char* rhs) {
+    String s(lhs);
+    s.concat(rhs);
+    return s;
+  }
+  friend String operator+(const char* lhs, const String& rhs) {
+    String s(lhs);
+    s.concat(rhs);
+    return s;
+  }
+  template <typename T>
+  friend String operator+(const String& lhs, const T& rhs) {
+    String s(lhs);
+    s.concat(rhs);
+    return s;
+  }
+
+ private:
+  std::string s_;
+};
+
+#endif  // HOSTBENCH_WSTRING_H_
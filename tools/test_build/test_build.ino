@@ -35,9 +35,22 @@ void loop() {
   // Test generic network functions
   modem.getRegistrationStatus();
   modem.isNetworkConnected();
+  uint32_t area   = 0;
+  uint32_t cellId = 0;
+  int8_t   act    = 0;
+  modem.getRegistrationInfo(area, cellId, act);
   modem.waitForNetwork();
   modem.waitForNetwork(15000L);
+  TinyGsmRequest request;
+  modem.waitForNetwork(request);
+  while (modem.poll()) {}
+  request.status();
   modem.getSignalQuality();
+  modem.startSignalMonitor(10000L);
+  TinyGsmSignalStats signal = modem.getSignalStats();
+  signal.rssi();
+  signal.last();
+  modem.stopSignalMonitor();
   modem.getLocalIP();
   modem.localIP();
 
@@ -64,6 +77,15 @@ void loop() {
 
   // Test TCP functions
   modem.maintain();
+#if defined(TINY_GSM_THREADED)
+  modem.startReader();
+  modem.readerRunning();
+  {
+    TinyGsmLock lock(modem.commandLock());
+    modem.getSignalQuality();
+  }
+  modem.stopReader();
+#endif
   TinyGsmClient client;
   TinyGsmClient client2(modem);
   TinyGsmClient client3(modem, 1);
@@ -74,6 +96,10 @@ void loop() {
   char resource[] = "something";
 
   client.connect(server, 80);
+#if defined(TINY_GSM_MODEM_SIM7000) || defined(TINY_GSM_MODEM_BG96)
+  client.connect(request, server, 80);
+  while (request.busy()) { modem.poll(); }
+#endif
 
   // Make a HTTP GET request:
   client.print(String("GET ") + resource + " HTTP/1.0\r\n");
@@ -89,6 +115,27 @@ void loop() {
   }
 
   client.stop();
+  modem.getPollCount();
+  modem.getPollHits();
+
+#if defined(TINY_GSM_MODEM_BG96)
+  client.setDirectPush(true);
+  client.connect(server, 80);
+  client.stop();
+#endif
+
+#if defined(TINY_GSM_MODEM_SIM800) || defined(TINY_GSM_MODEM_SIM808)
+  modem.setTransparentMode(true);
+  TinyGsmClientTransparent client_transparent(modem);
+  client_transparent.connect(server, 80);
+  client_transparent.print("Connection: close\r\n\r\n");
+  modem.getSignalQuality();
+  while (client_transparent.connected() && client_transparent.available()) {
+    client_transparent.read();
+  }
+  client_transparent.stop();
+  modem.setTransparentMode(false);
+#endif
 
 #if defined(TINY_GSM_MODEM_HAS_SSL)
   // modem.addCertificate();  // not yet impemented
@@ -132,6 +179,7 @@ void loop() {
 // Test the SMS functions
 #if defined(TINY_GSM_MODEM_HAS_SMS)
   modem.sendSMS(String("+380000000000"), String("Hello from "));
+  modem.sendSMS(request, "+380000000000", "Hello from ");
 
 #if not defined(TINY_GSM_MODEM_XBEE) && not defined(TINY_GSM_MODEM_SARAR4)
   modem.sendUSSD("*111#");